@@ -0,0 +1,227 @@
+// Copyright 2022 Rive
+
+using Microsoft.Extensions.Configuration;
+using RiveSharp;
+using SkiaSharp;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Text.Json;
+
+namespace Benchmarks;
+
+// Measures import, AdvanceAndApply and Draw times, interop traffic, and managed allocations for
+// the bundled corpus (plus an optional folder of .riv files), and reports them as JSON so runs can
+// be diffed.
+//
+//   Benchmarks [--rivs <folder>] [--frames 300] [--warmup 30] [--size 512] [--output out.json]
+//   Benchmarks --validate math [--cases 100000]
+internal class Benchmarks
+{
+    const double FPS = 60;
+
+    record TimingStats(double MeanUs, double MedianUs, double P95Us, double MaxUs);
+
+    record FileResult(string File,
+                      string Scene,
+                      long Bytes,
+                      double ImportMs,
+                      double SceneLoadMs,
+                      Dictionary<string, long> ImportCalls,
+                      TimingStats Advance,
+                      TimingStats Draw,
+                      Dictionary<string, double> CallsPerFrame,
+                      Dictionary<string, double> DelegateCallsPerFrame,
+                      double AllocatedBytesPerFrame);
+
+    record Report(string Runtime,
+                  string OS,
+                  string Architecture,
+                  int ProcessorCount,
+                  int Frames,
+                  int WarmupFrames,
+                  int Size,
+                  double Fps,
+                  List<FileResult> Files);
+
+    static int Main(string[] commandLineArgs)
+    {
+        var args = new ConfigurationBuilder().AddCommandLine(commandLineArgs).Build();
+        if (args["validate"] == "math")
+        {
+            return MathValidation.Run(int.Parse(args["cases"] ?? "100000"));
+        }
+        string? rivs = args["rivs"];
+        string? output = args["output"];
+        int frames = int.Parse(args["frames"] ?? "300");
+        int warmup = int.Parse(args["warmup"] ?? "30");
+        int size = int.Parse(args["size"] ?? "512");
+
+        // Sorted so results always line up between runs.
+        var rivFiles = new List<string>();
+        string corpus = Path.Combine(AppContext.BaseDirectory, "corpus");
+        if (Directory.Exists(corpus))
+        {
+            rivFiles.AddRange(Directory.GetFiles(corpus, "*.riv").OrderBy(f => f));
+        }
+        if (rivs != null)
+        {
+            rivFiles.AddRange(Directory.GetFiles(rivs, "*.riv").OrderBy(f => f));
+        }
+        if (rivFiles.Count == 0)
+        {
+            Console.WriteLine("ERROR: no .riv files to benchmark");
+            return -1;
+        }
+
+        var report = new Report(RuntimeInformation.FrameworkDescription,
+                                RuntimeInformation.OSDescription,
+                                RuntimeInformation.ProcessArchitecture.ToString(),
+                                Environment.ProcessorCount,
+                                frames,
+                                warmup,
+                                size,
+                                FPS,
+                                new List<FileResult>());
+        foreach (string riv in rivFiles)
+        {
+            var result = Run(riv, frames, warmup, size);
+            if (result == null)
+            {
+                Console.WriteLine($"WARNING: skipping '{riv}', which failed to load");
+                continue;
+            }
+            report.Files.Add(result);
+            Console.WriteLine($"{Path.GetFileName(riv),-32} import {result.ImportMs,8:F2} ms" +
+                              $"  advance {result.Advance.MeanUs,8:F1} us" +
+                              $"  draw {result.Draw.MeanUs,8:F1} us" +
+                              $"  alloc {result.AllocatedBytesPerFrame,8:F0} B/frame");
+        }
+
+        string json = JsonSerializer.Serialize(report, new JsonSerializerOptions
+        {
+            WriteIndented = true,
+            PropertyNamingPolicy = JsonNamingPolicy.CamelCase
+        });
+        if (output != null)
+        {
+            File.WriteAllText(output, json);
+            Console.WriteLine($"Wrote {output}");
+        }
+        else
+        {
+            Console.WriteLine(json);
+        }
+        return 0;
+    }
+
+    static FileResult? Run(string riv, int frames, int warmup, int size)
+    {
+        byte[] bytes = File.ReadAllBytes(riv);
+
+        InteropStats.Reset();
+        var stopwatch = Stopwatch.StartNew();
+        using var file = RiveFile.Load(bytes);
+        double importMs = stopwatch.Elapsed.TotalMilliseconds;
+        var importCalls = NamedCounts(InteropStats.GetCallCounts());
+        if (file == null)
+        {
+            return null;
+        }
+
+        stopwatch.Restart();
+        var scene = new Scene();
+        if (!scene.LoadFile(file) ||
+            !scene.LoadArtboard("") ||
+            !(scene.LoadStateMachine("") || scene.LoadAnimation("")))
+        {
+            return null;
+        }
+        double sceneLoadMs = stopwatch.Elapsed.TotalMilliseconds;
+
+        var surface = SKSurface.Create(new SKImageInfo(size, size,
+                                                       SKColorType.Rgba8888,
+                                                       SKAlphaType.Premul));
+        var canvas = surface.Canvas;
+        var renderer = new Renderer(canvas);
+        var frame = new AABB(0, 0, size, size);
+        var content = new AABB(0, 0, scene.Width, scene.Height);
+        void DrawFrame()
+        {
+            canvas.Clear(SKColors.White);
+            renderer.Save();
+            renderer.Align(Fit.Contain, Alignment.Center, frame, content);
+            scene.Draw(renderer);
+            renderer.Restore();
+            canvas.Flush();
+        }
+
+        scene.AdvanceAndApply(0);
+        for (int i = 0; i < warmup; ++i)
+        {
+            scene.AdvanceAndApply(1 / FPS);
+            DrawFrame();
+        }
+
+        var advanceTicks = new long[frames];
+        var drawTicks = new long[frames];
+        InteropStats.Reset();
+        var totalBefore = scene.GetStats().Total;
+        long allocatedBefore = GC.GetAllocatedBytesForCurrentThread();
+        for (int i = 0; i < frames; ++i)
+        {
+            long t0 = Stopwatch.GetTimestamp();
+            scene.AdvanceAndApply(1 / FPS);
+            long t1 = Stopwatch.GetTimestamp();
+            DrawFrame();
+            long t2 = Stopwatch.GetTimestamp();
+            advanceTicks[i] = t1 - t0;
+            drawTicks[i] = t2 - t1;
+        }
+        long allocated = GC.GetAllocatedBytesForCurrentThread() - allocatedBefore;
+        var frameCalls = InteropStats.GetCallCounts();
+        var totalAfter = scene.GetStats().Total;
+        var delegateCalls = new Dictionary<string, double>();
+        for (int i = 0; i < FrameStats.DelegateCount; ++i)
+        {
+            var which = (ManagedDelegate)i;
+            delegateCalls[which.ToString()] =
+                (double)(totalAfter.Calls(which) - totalBefore.Calls(which)) / frames;
+        }
+
+        return new FileResult(Path.GetFileName(riv),
+                              scene.Name,
+                              bytes.Length,
+                              importMs,
+                              sceneLoadMs,
+                              importCalls,
+                              Stats(advanceTicks),
+                              Stats(drawTicks),
+                              NamedCounts(frameCalls).ToDictionary(kv => kv.Key,
+                                                                   kv => (double)kv.Value / frames),
+                              delegateCalls,
+                              (double)allocated / frames);
+    }
+
+    static Dictionary<string, long> NamedCounts(long[] counts)
+    {
+        var named = new Dictionary<string, long>();
+        for (int i = 0; i < counts.Length; ++i)
+        {
+            named[((ManagedCallKind)i).ToString()] = counts[i];
+        }
+        return named;
+    }
+
+    static TimingStats Stats(long[] ticks)
+    {
+        if (ticks.Length == 0)
+        {
+            return new TimingStats(0, 0, 0, 0);
+        }
+        double[] us = ticks.Select(t => t * 1e6 / Stopwatch.Frequency).OrderBy(t => t).ToArray();
+        return new TimingStats(us.Average(),
+                               us[us.Length / 2],
+                               us[Math.Min(us.Length - 1, (int)(us.Length * .95))],
+                               us[us.Length - 1]);
+    }
+}
@@ -0,0 +1,174 @@
+// Copyright 2022 Rive
+
+using RiveSharp;
+using System.Runtime.InteropServices;
+
+namespace Benchmarks;
+
+// Checks that the managed Mat2D and Renderer.ComputeAlignment math matches rive's native
+// implementation bit-for-bit, over a seeded sweep of inputs. Worth running on every architecture
+// rive ships for, since a rive built with FMA contraction on (clang's default on ARM64) fails it.
+//
+//   Benchmarks --validate math [--cases 100000]
+internal static class MathValidation
+{
+    [StructLayout(LayoutKind.Sequential)]
+    struct ComputeAlignmentArgs
+    {
+        public int Fit;
+        public float AlignX;
+        public float AlignY;
+        public AABB Frame;
+        public AABB Content;
+        public Mat2D Matrix;
+    }
+
+    // The native reference implementations.
+    static class NativeMethods
+    {
+        [DllImport("rive", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Mat2D_Multiply(Mat2D a, Mat2D b, out Mat2D c);
+
+        [DllImport("rive", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Mat2D_MultiplyVec2D(Mat2D a, Vec2D b, out Vec2D c);
+
+        [DllImport("rive", CallingConvention = CallingConvention.Cdecl)]
+        public static extern sbyte Mat2D_Invert(Mat2D a, out Mat2D b);
+
+        [DllImport("rive", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Renderer_ComputeAlignment(ref ComputeAlignmentArgs args);
+    }
+
+    static readonly Alignment[] Alignments =
+    {
+        Alignment.TopLeft, Alignment.TopCenter, Alignment.TopRight,
+        Alignment.CenterLeft, Alignment.Center, Alignment.CenterRight,
+        Alignment.BottomLeft, Alignment.BottomCenter, Alignment.BottomRight
+    };
+
+    static int s_failures;
+
+    public static int Run(int cases)
+    {
+        var random = new Random(0x5eed);
+        var points = new Vec2D[257];  // Odd, so MapPoints handles a remainder.
+        var mapped = new Vec2D[points.Length];
+        for (int i = 0; i < cases; ++i)
+        {
+            var a = RandomMat2D(random);
+            var b = RandomMat2D(random);
+
+            NativeMethods.Mat2D_Multiply(a, b, out var product);
+            Check("multiply", a * b, product);
+
+            bool invertible = NativeMethods.Mat2D_Invert(a, out var inverse) != 0;
+            bool managedInvertible = a.Invert(out var managedInverse);
+            if (managedInvertible != invertible)
+            {
+                Fail($"invert: invertible {managedInvertible}, expected {invertible}");
+            }
+            else if (invertible)
+            {
+                Check("invert", managedInverse, inverse);
+            }
+
+            var p = new Vec2D(RandomFloat(random), RandomFloat(random));
+            NativeMethods.Mat2D_MultiplyVec2D(a, p, out var mappedPoint);
+            Check("multiplyVec2D", a * p, mappedPoint);
+
+            if (i % 64 == 0)
+            {
+                for (int j = 0; j < points.Length; ++j)
+                {
+                    points[j] = new Vec2D(RandomFloat(random), RandomFloat(random));
+                }
+                a.MapPoints(points, mapped);
+                for (int j = 0; j < points.Length; ++j)
+                {
+                    NativeMethods.Mat2D_MultiplyVec2D(a, points[j], out var expected);
+                    Check("mapPoints", mapped[j], expected);
+                }
+            }
+
+            var args = new ComputeAlignmentArgs
+            {
+                Fit = random.Next(7),
+                Frame = RandomAABB(random),
+                Content = RandomAABB(random)
+            };
+            var alignment = Alignments[random.Next(Alignments.Length)];
+            args.AlignX = alignment.X;
+            args.AlignY = alignment.Y;
+            NativeMethods.Renderer_ComputeAlignment(ref args);
+            Check($"computeAlignment({(Fit)args.Fit})",
+                  Renderer.ComputeAlignment((Fit)args.Fit, alignment, args.Frame, args.Content),
+                  args.Matrix);
+
+            if (s_failures >= 20)
+            {
+                break;
+            }
+        }
+        Console.WriteLine(s_failures == 0 ? $"Math validation passed ({cases} cases)"
+                                          : $"Math validation FAILED ({s_failures} mismatches)");
+        return s_failures == 0 ? 0 : -1;
+    }
+
+    // Mixes ordinary values with zeros, negatives, and very large and small magnitudes.
+    static float RandomFloat(Random random)
+    {
+        switch (random.Next(8))
+        {
+            case 0: return 0;
+            case 1: return random.Next(-4, 5);
+            case 2: return (float)(random.NextDouble() * 1e-6);
+            case 3: return (float)((random.NextDouble() - .5) * 1e7);
+            default: return (float)((random.NextDouble() - .5) * 2000);
+        }
+    }
+
+    static Mat2D RandomMat2D(Random random)
+    {
+        return new Mat2D(RandomFloat(random), RandomFloat(random), RandomFloat(random),
+                         RandomFloat(random), RandomFloat(random), RandomFloat(random));
+    }
+
+    static AABB RandomAABB(Random random)
+    {
+        float x = RandomFloat(random), y = RandomFloat(random);
+        return new AABB(x, y, x + Math.Abs(RandomFloat(random)), y + Math.Abs(RandomFloat(random)));
+    }
+
+    static void Check(string what, Mat2D actual, Mat2D expected)
+    {
+        if (!SameBits(actual.X1, expected.X1) || !SameBits(actual.Y1, expected.Y1) ||
+            !SameBits(actual.X2, expected.X2) || !SameBits(actual.Y2, expected.Y2) ||
+            !SameBits(actual.Tx, expected.Tx) || !SameBits(actual.Ty, expected.Ty))
+        {
+            Fail($"{what}: got {Format(actual)}, expected {Format(expected)}");
+        }
+    }
+
+    static void Check(string what, Vec2D actual, Vec2D expected)
+    {
+        if (!SameBits(actual.X, expected.X) || !SameBits(actual.Y, expected.Y))
+        {
+            Fail($"{what}: got ({actual.X}, {actual.Y}), expected ({expected.X}, {expected.Y})");
+        }
+    }
+
+    // NaNs compare equal to any other NaN, since their payloads aren't meaningful.
+    static bool SameBits(float a, float b)
+    {
+        return BitConverter.SingleToInt32Bits(a) == BitConverter.SingleToInt32Bits(b) ||
+               (float.IsNaN(a) && float.IsNaN(b));
+    }
+
+    static string Format(Mat2D m) => $"[{m.X1}, {m.Y1}, {m.X2}, {m.Y2}, {m.Tx}, {m.Ty}]";
+
+    static void Fail(string message)
+    {
+        Console.WriteLine($"MISMATCH {message}");
+        ++s_failures;
+    }
+}
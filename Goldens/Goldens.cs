@@ -68,8 +68,6 @@ internal class Goldens
             double duration = scene.DurationSeconds;
             double frameDuration = duration / FRAMES;
 
-            scene.AdvanceAndApply(0);
-
             var renderer = new Renderer(canvas);
             renderer.Translate(GAP, GAP);
             renderer.Save();
@@ -79,14 +77,15 @@ internal class Goldens
                 {
                     renderer.Save();
 
+                    // Seek to each frame rather than accumulating deltas, so every cell is
+                    // evaluated at exactly its own time.
+                    scene.SeekTo((y * W + x) * frameDuration);
                     renderer.Translate(x * (CELL + GAP), y * (CELL + GAP));
                     renderer.Align(Fit.Cover, Alignment.Center,
                                    new AABB(0, 0, CELL, CELL),
                                    new AABB(0, 0, scene.Width, scene.Height));
                     scene.Draw(renderer);
 
-                    scene.AdvanceAndApply(frameDuration);
-
                     renderer.Restore();
                 }
             }
@@ -86,8 +86,7 @@ namespace RiveSharp.Views
         {
             var player = (RivePlayer)d;
             var newSourceName = (string)e.NewValue;
-            // Clear the current Scene while we wait for the new one to load.
-            player.sceneActionsQueue.Enqueue(() => player._scene = new Scene());
+            // The current Scene keeps playing until the new one has loaded and gets swapped in.
             if (player._activeSourceFileLoader != null)
             {
                 player._activeSourceFileLoader.Cancel();
@@ -103,7 +102,7 @@ namespace RiveSharp.Views
         {
             var player = (RivePlayer)d;
             var newArtboardName = (string)e.NewValue;
-            player.sceneActionsQueue.Enqueue(() => player._artboardName = newArtboardName);
+            player.EnqueueSceneAction(() => player._artboardName = newArtboardName);
             if (player._activeSourceFileLoader != null)
             {
                 // If a file is currently loading async, it will apply the new artboard once
@@ -113,7 +112,7 @@ namespace RiveSharp.Views
             }
             else
             {
-                player.sceneActionsQueue.Enqueue(() => player.UpdateScene(SceneUpdates.Artboard));
+                player.EnqueueSceneAction(() => player.UpdateScene(SceneUpdates.Artboard));
             }
         }
 
@@ -121,7 +120,7 @@ namespace RiveSharp.Views
         {
             var player = (RivePlayer)d;
             var newStateMachineName = (string)e.NewValue;
-            player.sceneActionsQueue.Enqueue(() => player._stateMachineName = newStateMachineName);
+            player.EnqueueSceneAction(() => player._stateMachineName = newStateMachineName);
             if (player._activeSourceFileLoader != null)
             {
                 // If a file is currently loading async, it will apply the new state machine
@@ -131,7 +130,7 @@ namespace RiveSharp.Views
             }
             else
             {
-                player.sceneActionsQueue.Enqueue(() => player.UpdateScene(SceneUpdates.AnimationOrStateMachine));
+                player.EnqueueSceneAction(() => player.UpdateScene(SceneUpdates.AnimationOrStateMachine));
             }
         }
 
@@ -139,11 +138,11 @@ namespace RiveSharp.Views
         {
             var player = (RivePlayer)d;
             var newAnimationName = (string)e.NewValue;
-            player.sceneActionsQueue.Enqueue(() => player._animationName = newAnimationName);
+            player.EnqueueSceneAction(() => player._animationName = newAnimationName);
             // If a file is currently loading async, it will apply the new animation once it completes.
             if (player._activeSourceFileLoader == null)
             {
-                player.sceneActionsQueue.Enqueue(() => player.UpdateScene(SceneUpdates.AnimationOrStateMachine));
+                player.EnqueueSceneAction(() => player.UpdateScene(SceneUpdates.AnimationOrStateMachine));
             }
         }
 
@@ -4,6 +4,7 @@ using SkiaSharp.Views.UWP;
 using System;
 using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.IO;
 using System.Net;
 using System.Threading;
@@ -13,6 +14,7 @@ using Windows.Storage;
 using Windows.UI.Core;
 using Windows.UI.Xaml;
 using Windows.UI.Xaml.Input;
+using Windows.UI.Xaml.Media;
 
 namespace RiveSharp.Views
 {
@@ -24,14 +26,16 @@ namespace RiveSharp.Views
         public RivePlayer()
         {
             this.StateMachineInputs = new StateMachineInputCollection(this);
+            _pointerTarget = _scene;
             this.Loaded += OnLoaded;
-            this.PointerPressed +=
-                (object s, PointerRoutedEventArgs e) => HandlePointerEvent(_scene.PointerDown, e);
-            this.PointerMoved +=
-                (object s, PointerRoutedEventArgs e) => HandlePointerEvent(_scene.PointerMove, e);
-            this.PointerReleased +=
-                (object s, PointerRoutedEventArgs e) => HandlePointerEvent(_scene.PointerUp, e);
+            this.PointerPressed += (object s, PointerRoutedEventArgs e) =>
+                HandlePointerEvent(PointerEventType.Down, e);
+            this.PointerMoved += (object s, PointerRoutedEventArgs e) =>
+                HandlePointerEvent(PointerEventType.Move, e);
+            this.PointerReleased += (object s, PointerRoutedEventArgs e) =>
+                HandlePointerEvent(PointerEventType.Up, e);
             this.PaintSurface += OnPaintSurface;
+            this.Unloaded += OnUnloaded;
         }
 
         private async void LoadSourceFileDataAsync(string name, CancellationToken cancellationToken)
@@ -55,15 +59,53 @@ namespace RiveSharp.Views
                     fileStream.Dispose();  // Don't keep the file open.
                 }
             }
-            if (data != null && !cancellationToken.IsCancellationRequested)
+            if (cancellationToken.IsCancellationRequested)
             {
-                sceneActionsQueue.Enqueue(() => UpdateScene(SceneUpdates.File, data));
-                // Apply deferred state machine inputs once the scene is fully loaded.
-                foreach (Action stateMachineInput in _deferredSMInputsDuringFileLoad)
+                // A newer load has taken over _activeSourceFileLoader and the deferred inputs.
+                return;
+            }
+
+            // Import the file (decoding its images along the way) and instantiate the artboard on
+            // a worker thread, so a large file doesn't stall the render thread for several frames.
+            // The current scene keeps playing until the new one is swapped in by a single render-
+            // thread action.
+            string artboardName = Artboard;
+            string stateMachineName = StateMachine;
+            string animationName = Animation;
+            var scene = new Scene();
+            if (data != null)
+            {
+                await Task.Run(() => ApplySceneUpdates(scene,
+                                                       SceneUpdates.File,
+                                                       data,
+                                                       artboardName,
+                                                       stateMachineName,
+                                                       animationName));
+                if (cancellationToken.IsCancellationRequested)
                 {
-                    sceneActionsQueue.Enqueue(stateMachineInput);
+                    return;
                 }
             }
+            EnqueueSceneAction(() =>
+            {
+                _scene = scene;
+                Volatile.Write(ref _pointerTarget, scene);
+                _inputHandles.Clear();
+                // Catch up with any names that changed while the file was loading.
+                if (_artboardName != artboardName)
+                {
+                    UpdateScene(SceneUpdates.Artboard);
+                }
+                else if (_stateMachineName != stateMachineName || _animationName != animationName)
+                {
+                    UpdateScene(SceneUpdates.AnimationOrStateMachine);
+                }
+            });
+            // Apply deferred state machine inputs once the scene is fully loaded.
+            foreach (Action stateMachineInput in _deferredSMInputsDuringFileLoad)
+            {
+                EnqueueSceneAction(stateMachineInput);
+            }
             _deferredSMInputsDuringFileLoad = null;
             _activeSourceFileLoader = null;
         }
@@ -80,28 +122,77 @@ namespace RiveSharp.Views
             }
             else
             {
-                sceneActionsQueue.Enqueue(stateMachineInput);
+                EnqueueSceneAction(stateMachineInput);
             }
         }
 
         public void SetBool(string name, bool value)
         {
-            EnqueueStateMachineInput(() => _scene.SetBool(name, value));
+            EnqueueStateMachineInput(() =>
+            {
+                int handle = GetInputHandle(name);
+                if (handle >= 0)
+                {
+                    _scene.SetBool(handle, value);
+                }
+                else
+                {
+                    _scene.SetBool(name, value);
+                }
+            });
         }
 
         public void SetNumber(string name, float value)
         {
-            EnqueueStateMachineInput(() => _scene.SetNumber(name, value));
+            EnqueueStateMachineInput(() =>
+            {
+                int handle = GetInputHandle(name);
+                if (handle >= 0)
+                {
+                    _scene.SetNumber(handle, value);
+                }
+                else
+                {
+                    _scene.SetNumber(name, value);
+                }
+            });
         }
 
         public void FireTrigger(string name)
         {
-            EnqueueStateMachineInput(() => _scene.FireTrigger(name));
+            EnqueueStateMachineInput(() =>
+            {
+                int handle = GetInputHandle(name);
+                if (handle >= 0)
+                {
+                    _scene.FireTrigger(handle);
+                }
+                else
+                {
+                    _scene.FireTrigger(name);
+                }
+            });
         }
 
-        private delegate void PointerHandler(Vec2D pos);
+        // Render-thread cache of resolved state machine input handles for _scene. Cleared whenever
+        // the scene or its state machine changes.
+        private readonly Dictionary<string, int> _inputHandles = new Dictionary<string, int>();
+
+        // Called from the render thread. Returns -1 if the input does not exist.
+        private int GetInputHandle(string name)
+        {
+            if (!_inputHandles.TryGetValue(name, out int handle))
+            {
+                handle = _scene.GetInputHandle(name);
+                if (_scene.IsLoaded)
+                {
+                    _inputHandles[name] = handle;
+                }
+            }
+            return handle;
+        }
 
-        private void HandlePointerEvent(PointerHandler handler, PointerRoutedEventArgs e)
+        private void HandlePointerEvent(PointerEventType type, PointerRoutedEventArgs e)
         {
             if (_activeSourceFileLoader != null)
             {
@@ -109,50 +200,137 @@ namespace RiveSharp.Views
                 return;
             }
 
-            // Capture the viewSize and pointerPos at the time of the event.
+            // Queue the event natively, normalized to the view's size, for the next AdvanceAndApply
+            // to dispatch. The render thread keeps the scene's pointer transform up to date, so
+            // nothing needs to be computed or allocated here.
             var viewSize = this.ActualSize;
             var pointerPos = e.GetCurrentPoint(this).Position;
+            if (viewSize.X > 0 && viewSize.Y > 0)
+            {
+                Volatile.Read(ref _pointerTarget).QueuePointerEvent(
+                    type,
+                    new Vec2D((float)pointerPos.X / viewSize.X, (float)pointerPos.Y / viewSize.Y));
+                // Even an idle scene needs a frame to dispatch the event.
+                _pointerEventsPending = true;
+                WakeUp();
+            }
+        }
+
+        // The scene that pointer events get queued into: the render thread's _scene, published
+        // whenever it's replaced. Events that race with a swap land in the outgoing scene, which
+        // is what was on screen when they happened, and are dropped along with it.
+        Scene _pointerTarget;
+
+        // Set on the UI thread when a pointer event is queued, and cleared by the render thread
+        // right before AdvanceAndApply dispatches the queue. Keeps an idle player painting until
+        // the event has been dispatched.
+        volatile bool _pointerEventsPending = false;
 
-            // Forward the pointer event to the render thread.
-            sceneActionsQueue.Enqueue(() =>
+        // The alignment that _pointerTransformScene's pointer transform was computed from. Only
+        // accessed on the render thread.
+        Scene _pointerTransformScene;
+        Mat2D _pointerTransformAlignment;
+
+        // Called from the render thread. Pointer events are queued in normalized view coordinates.
+        // Scaling them to the render target and inverting the alignment maps them into the
+        // artboard, the same as if they were in DIPs with an alignment computed for the DIP size.
+        private void UpdatePointerTransform(Mat2D alignment, int width, int height)
+        {
+            var a = _pointerTransformAlignment;
+            if (_pointerTransformScene == _scene &&
+                a.X1 == alignment.X1 && a.Y1 == alignment.Y1 &&
+                a.X2 == alignment.X2 && a.Y2 == alignment.Y2 &&
+                a.Tx == alignment.Tx && a.Ty == alignment.Ty)
             {
-                Mat2D mat = ComputeAlignment(viewSize.X, viewSize.Y);
-                if (mat.Invert(out var inverse))
-                {
-                    Vec2D artboardPos = inverse * new Vec2D((float)pointerPos.X, (float)pointerPos.Y);
-                    handler(artboardPos);
-                }
-            });
+                return;
+            }
+            if (alignment.Invert(out var inverse))
+            {
+                _scene.SetPointerTransform(inverse * Mat2D.FromScale(width, height));
+                _pointerTransformScene = _scene;
+                _pointerTransformAlignment = alignment;
+            }
         }
 
-        // Incremented when the "InvalLoop" (responsible for scheduling PaintSurface events) should
-        // terminate.
-        int _invalLoopContinuationToken = 0;
+        // PaintSurface events are scheduled once per display frame, from CompositionTarget.Rendering,
+        // while the scene is animating or there are scene actions to run. Once the scene settles,
+        // the Rendering handler unsubscribes itself and the player goes fully idle until
+        // EnqueueSceneAction wakes it up. Only accessed on the UI thread.
+        bool _renderingSubscribed = false;
+        bool _windowVisible = true;
+
+        // Set by the render thread when the last AdvanceAndApply reported that the scene won't
+        // change without further input.
+        volatile bool _sceneIdle = false;
 
         private void OnLoaded(object sender, RoutedEventArgs e)
         {
             Window.Current.VisibilityChanged += (object s, VisibilityChangedEventArgs vce) =>
             {
-                ++_invalLoopContinuationToken;  // Terminate the existing inval loop (if any).
+                _windowVisible = vce.Visible;
                 if (vce.Visible)
                 {
-                    InvalLoopAsync(_invalLoopContinuationToken);
+                    WakeUp();
+                }
+                else
+                {
+                    StopRendering();
                 }
             };
+            WakeUp();
+        }
+
+        // CompositionTarget.Rendering is a static event, so it would keep an unloaded player alive.
+        private void OnUnloaded(object sender, RoutedEventArgs e)
+        {
+            StopRendering();
+        }
+
+        // Queues an action for the render thread, and makes sure a frame is coming to run it.
+        private void EnqueueSceneAction(Action action)
+        {
+            sceneActionsQueue.Enqueue(action);
+            WakeUp();
         }
 
-        // Schedules continual PaintSurface events at 120fps until the window is no longer visible.
-        // (Multiple calls to Invalidate() between PaintSurface events are coalesced.)
-        private async void InvalLoopAsync(int continuationToken)
+        // Resumes painting once per display frame. Can be called from any thread.
+        private void WakeUp()
         {
-            while (continuationToken == _invalLoopContinuationToken)
+            if (!Dispatcher.HasThreadAccess)
+            {
+                _ = Dispatcher.RunAsync(CoreDispatcherPriority.Normal, WakeUp);
+                return;
+            }
+            if (_windowVisible && !_renderingSubscribed)
             {
-                this.Invalidate();
-                await Task.Delay(TimeSpan.FromMilliseconds(8));  // 120 fps
+                CompositionTarget.Rendering += OnCompositionRendering;
+                _renderingSubscribed = true;
             }
         }
 
-        // _scene is used on the render thread exclusively.
+        private void StopRendering()
+        {
+            if (_renderingSubscribed)
+            {
+                CompositionTarget.Rendering -= OnCompositionRendering;
+                _renderingSubscribed = false;
+            }
+        }
+
+        // Called on the UI thread once per display frame while subscribed. (Multiple calls to
+        // Invalidate() between PaintSurface events are coalesced.)
+        private void OnCompositionRendering(object sender, object e)
+        {
+            if (_sceneIdle && !_pointerEventsPending && sceneActionsQueue.IsEmpty)
+            {
+                StopRendering();
+                return;
+            }
+            this.Invalidate();
+        }
+
+        // _scene is used on the render thread exclusively. (The UI thread queues pointer events
+        // through _pointerTarget instead.)
         Scene _scene = new Scene();
 
         // Source actions originating from other threads must be funneled through this queue.
@@ -171,7 +349,13 @@ namespace RiveSharp.Views
             AnimationOrStateMachine = 1,
         };
 
-        DateTime _lastPaintTime;
+        // Monotonic clock for advancing the scene.
+        readonly Stopwatch _clock = Stopwatch.StartNew();
+
+        // Clock time of the last paint, or null if the next paint shouldn't advance time: on the
+        // first frame, and when waking up from idle (otherwise the scene would jump ahead by
+        // however long it sat idle).
+        TimeSpan? _lastPaintTime;
 
         private void OnPaintSurface(object sender, SKPaintGLSurfaceEventArgs e)
         {
@@ -183,52 +367,81 @@ namespace RiveSharp.Views
 
             if (!_scene.IsLoaded)
             {
+                // Nothing to animate until a load gets queued.
+                _lastPaintTime = null;
+                _pointerEventsPending = false;
+                _sceneIdle = true;
                 return;
             }
 
-            // Run the animation.
-            var now = DateTime.Now;
-            if (_lastPaintTime != null)
-            {
-                _scene.AdvanceAndApply((now - _lastPaintTime).TotalSeconds);
-            }
-            _lastPaintTime = now;
+            // Run the animation, after dispatching any queued pointer events.
+            int width = e.BackendRenderTarget.Width;
+            int height = e.BackendRenderTarget.Height;
+            var alignment = ComputeAlignment(width, height);
+            UpdatePointerTransform(alignment, width, height);
+            var now = _clock.Elapsed;
+            double elapsedSeconds = _lastPaintTime.HasValue
+                ? (now - _lastPaintTime.Value).TotalSeconds
+                : 0;
+            // Cleared before dispatching, so an event queued during the advance sets it again and
+            // gets another frame.
+            _pointerEventsPending = false;
+            bool animating = _scene.AdvanceAndApply(elapsedSeconds);
+            _lastPaintTime = animating ? now : (TimeSpan?)null;
+            _sceneIdle = !animating;
 
             // Render.
             e.Surface.Canvas.Clear();
             var renderer = new Renderer(e.Surface.Canvas);
             renderer.Save();
-            renderer.Transform(ComputeAlignment(e.BackendRenderTarget.Width, e.BackendRenderTarget.Height));
+            renderer.Transform(alignment);
             _scene.Draw(renderer);
             renderer.Restore();
         }
 
         // Called from the render thread. Updates _scene according to updates.
         void UpdateScene(SceneUpdates updates, byte[] sourceFileData = null)
+        {
+            _inputHandles.Clear();
+            ApplySceneUpdates(_scene,
+                              updates,
+                              sourceFileData,
+                              _artboardName,
+                              _stateMachineName,
+                              _animationName);
+        }
+
+        // Does not touch any player state, so it can also prepare a Scene on a worker thread.
+        static void ApplySceneUpdates(Scene scene,
+                                      SceneUpdates updates,
+                                      byte[] sourceFileData,
+                                      string artboardName,
+                                      string stateMachineName,
+                                      string animationName)
         {
             if (updates >= SceneUpdates.File)
             {
-                _scene.LoadFile(sourceFileData);
+                scene.LoadFile(sourceFileData);
             }
             if (updates >= SceneUpdates.Artboard)
             {
-                _scene.LoadArtboard(_artboardName);
+                scene.LoadArtboard(artboardName);
             }
             if (updates >= SceneUpdates.AnimationOrStateMachine)
             {
-                if (!String.IsNullOrEmpty(_stateMachineName))
+                if (!String.IsNullOrEmpty(stateMachineName))
                 {
-                    _scene.LoadStateMachine(_stateMachineName);
+                    scene.LoadStateMachine(stateMachineName);
                 }
-                else if (!String.IsNullOrEmpty(_animationName))
+                else if (!String.IsNullOrEmpty(animationName))
                 {
-                    _scene.LoadAnimation(_animationName);
+                    scene.LoadAnimation(animationName);
                 }
                 else
                 {
-                    if (!_scene.LoadStateMachine(null))
+                    if (!scene.LoadStateMachine(null))
                     {
-                        _scene.LoadAnimation(null);
+                        scene.LoadAnimation(null);
                     }
                 }
             }
@@ -1,6 +1,7 @@
 // Copyright 2022 Rive
 
 using System;
+using System.Numerics;
 using System.Runtime.InteropServices;
 
 namespace RiveSharp
@@ -65,38 +66,95 @@ namespace RiveSharp
             this.Ty = ty;
         }
 
-        public static unsafe Mat2D operator *(Mat2D a, Mat2D b)
+        // The math below is done in managed code, rather than calling into rive, because transforms
+        // get built on every pointer event and every paint. Each element is computed with the same
+        // float operations, in the same order, as rive::Mat2D, so the results are bit-for-bit
+        // identical to the native ones (see MathValidation in Benchmarks). That relies on rive
+        // being built without FMA contraction, which premake5.lua turns off for clang; a build of
+        // rive that fuses a*b + c*d (clang's default on ARM64) can differ in the last bit.
+
+        public static Mat2D operator *(Mat2D a, Mat2D b)
         {
-            var product = new Mat2D();
-            RiveAPI.Mat2D_Multiply(a, b, &product);
-            return product;
+            // The 2x2 part, as two columns at a time: [a0*b0 + a2*b1, a1*b0 + a3*b1,
+            // a0*b2 + a2*b3, a1*b2 + a3*b3].
+            var a01 = new Vector4(a.X1, a.Y1, a.X1, a.Y1);
+            var a23 = new Vector4(a.X2, a.Y2, a.X2, a.Y2);
+            var b02 = new Vector4(b.X1, b.X1, b.X2, b.X2);
+            var b13 = new Vector4(b.Y1, b.Y1, b.Y2, b.Y2);
+            var m = a01 * b02 + a23 * b13;
+            var t = new Vector2(a.X1, a.Y1) * b.Tx +
+                    new Vector2(a.X2, a.Y2) * b.Ty +
+                    new Vector2(a.Tx, a.Ty);
+            return new Mat2D(m.X, m.Y, m.Z, m.W, t.X, t.Y);
         }
 
-        public static unsafe Vec2D operator *(Mat2D a, Vec2D b)
+        public static Vec2D operator *(Mat2D a, Vec2D b)
         {
-            var product = new Vec2D();
-            RiveAPI.Mat2D_MultiplyVec2D(a, b, &product);
-            return product;
+            return new Vec2D(a.X1 * b.X + a.X2 * b.Y + a.Tx,
+                             a.Y1 * b.X + a.Y2 * b.Y + a.Ty);
         }
 
-        public unsafe bool Invert(out Mat2D inverse)
+        public bool Invert(out Mat2D inverse)
         {
-            var result = new Mat2D();
-            if (RiveAPI.Mat2D_Invert(this, &result) != 0)
-            {
-                inverse = result;
-                return true;
-            }
-            else
+            float det = X1 * Y2 - Y1 * X2;
+            if (det == 0)
             {
                 inverse = Mat2D.Identity;
                 return false;
             }
+            det = 1 / det;
+            inverse = new Mat2D(Y2 * det,
+                                -Y1 * det,
+                                -X2 * det,
+                                X1 * det,
+                                (X2 * Ty - Y2 * Tx) * det,
+                                (Y1 * Tx - X1 * Ty) * det);
+            return true;
         }
 
         public Mat2D InvertOrIdentity()
         {
             return Invert(out Mat2D inverse) ? inverse : Mat2D.Identity;
         }
+
+        // Transforms every point in src into dst, which may be the same span, two lanes at a time.
+        public void MapPoints(ReadOnlySpan<Vec2D> src, Span<Vec2D> dst)
+        {
+            if (dst.Length < src.Length)
+            {
+                throw new ArgumentException("dst must be at least as long as src.");
+            }
+            var col0 = new Vector2(X1, Y1);
+            var col1 = new Vector2(X2, Y2);
+            var translate = new Vector2(Tx, Ty);
+            var srcVectors = MemoryMarshal.Cast<Vec2D, Vector2>(src);
+            var dstVectors = MemoryMarshal.Cast<Vec2D, Vector2>(dst);
+            for (int i = 0; i < srcVectors.Length; ++i)
+            {
+                var p = srcVectors[i];
+                dstVectors[i] = col0 * p.X + col1 * p.Y + translate;
+            }
+        }
+
+        // Transforms the points in place.
+        public void MapPoints(Span<Vec2D> points)
+        {
+            MapPoints(points, points);
+        }
+
+        // Returns the axis-aligned bounds of the transformed rectangle. Each output coordinate is a
+        // sum of terms that depend on only one input coordinate, so its extremes come from the
+        // extremes of each term.
+        public AABB MapBounds(AABB bounds)
+        {
+            float ax = X1 * bounds.MinX, bx = X1 * bounds.MaxX;
+            float cx = X2 * bounds.MinY, dx = X2 * bounds.MaxY;
+            float ay = Y1 * bounds.MinX, by = Y1 * bounds.MaxX;
+            float cy = Y2 * bounds.MinY, dy = Y2 * bounds.MaxY;
+            return new AABB(Tx + Math.Min(ax, bx) + Math.Min(cx, dx),
+                            Ty + Math.Min(ay, by) + Math.Min(cy, dy),
+                            Tx + Math.Max(ax, bx) + Math.Max(cx, dx),
+                            Ty + Math.Max(ay, by) + Math.Max(cy, dy));
+        }
     }
 }
@@ -40,9 +40,9 @@ namespace RiveSharp
             return new RenderPaint();
         }
 
-        RenderImage DecodeImage(byte[] data)
+        RenderImage DecodeImage(SKData data)
         {
-            return RenderImage.Decode(data);
+            return RenderImage.DecodeAsync(data);
         }
 
         [MonoPInvokeCallback(typeof(FactoryDelegates.MakeRenderPathDelegate))]
@@ -79,9 +79,9 @@ namespace RiveSharp
         static IntPtr DecodeImageCallback(IntPtr @ref, IntPtr bytesArray, int nBytes)
         {
             var factory = RiveAPI.CastNativeRef<Factory>(@ref);
-            var bytes = new byte[nBytes];
-            Marshal.Copy(bytesArray, bytes, 0, nBytes);
-            var image = factory.DecodeImage(bytes);
+            // The bytes belong to the File being imported, so copy them before decoding finishes on
+            // another thread. The copy is disposed once its image has decoded.
+            var image = factory.DecodeImage(SKData.CreateCopy(bytesArray, nBytes));
             return (IntPtr)(image != null ? RiveAPI.CreateNativeRef(image)
                                           : IntPtr.Zero);
         }
@@ -0,0 +1,94 @@
+// Copyright 2022 Rive
+
+using System;
+using System.Threading;
+
+namespace RiveSharp
+{
+    // Integer-slot table of the managed objects that native code holds references to. A ref is its
+    // slot index + 1, so IntPtr.Zero still means "no object". Unlike GCHandles, slots are plain
+    // array entries: making one doesn't allocate a runtime handle, looking one up is an array read,
+    // and native code can release thousands of them in a single call.
+    internal static class HandleTable
+    {
+        static readonly InteropDelegates Delegates = new InteropDelegates
+        {
+            ReleaseRefs = ReleaseRefsCallback
+        };
+
+        static HandleTable()
+        {
+            RiveAPI.Interop_RegisterDelegates(Delegates);
+        }
+
+        static readonly object Lock = new object();
+        // Only written under Lock. When it grows, the larger copy is published before any of its
+        // new slots are handed out, so lookups can read it without taking the lock.
+        static object[] s_objects = new object[1024];
+        static int s_usedCount;  // Slots [0..s_usedCount) have been handed out at least once.
+        static int[] s_freeSlots = new int[1024];
+        static int s_freeCount;
+
+        public static IntPtr Alloc(Object obj)
+        {
+            lock (Lock)
+            {
+                int slot;
+                if (s_freeCount > 0)
+                {
+                    slot = s_freeSlots[--s_freeCount];
+                }
+                else
+                {
+                    if (s_usedCount == s_objects.Length)
+                    {
+                        var grown = new object[s_objects.Length * 2];
+                        Array.Copy(s_objects, grown, s_usedCount);
+                        Volatile.Write(ref s_objects, grown);
+                    }
+                    slot = s_usedCount++;
+                }
+                s_objects[slot] = obj;
+                return new IntPtr(slot + 1);
+            }
+        }
+
+        public static Object Get(IntPtr @ref)
+        {
+            return Volatile.Read(ref s_objects)[(int)@ref - 1];
+        }
+
+        public static void Free(IntPtr @ref)
+        {
+            lock (Lock)
+            {
+                FreeLocked(@ref);
+            }
+        }
+
+        static void FreeLocked(IntPtr @ref)
+        {
+            int slot = (int)@ref - 1;
+            s_objects[slot] = null;
+            if (s_freeCount == s_freeSlots.Length)
+            {
+                Array.Resize(ref s_freeSlots, s_freeSlots.Length * 2);
+            }
+            s_freeSlots[s_freeCount++] = slot;
+        }
+
+        [MonoPInvokeCallback(typeof(InteropDelegates.ReleaseRefsDelegate))]
+        static unsafe void ReleaseRefsCallback(IntPtr refsArray,  // IntPtr[count]
+                                               Int32 count)
+        {
+            var refs = (IntPtr*)refsArray;
+            lock (Lock)
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    FreeLocked(refs[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+// Copyright 2022 Rive
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace RiveSharp
+{
+    // The delegate structs that native code calls back into. Must match ManagedCallKind in
+    // RiveSharpInterop.cpp.
+    public enum ManagedCallKind
+    {
+        RenderPath = 0,
+        RenderImage = 1,
+        RenderPaint = 2,
+        Renderer = 3,
+        Factory = 4,
+        Scene = 5
+    };
+
+    // Every individual reverse P/Invoke, grouped by delegate struct. Must match ManagedDelegate in
+    // RiveSharpInterop.cpp.
+    public enum ManagedDelegate
+    {
+        ReleaseRefs = 0,
+        RenderPathCommit = 1,
+        RenderImageWidth = 2,
+        RenderImageHeight = 3,
+        RenderPaintStyle = 4,
+        RenderPaintColor = 5,
+        RenderPaintLinearGradient = 6,
+        RenderPaintRadialGradient = 7,
+        RenderPaintThickness = 8,
+        RenderPaintJoin = 9,
+        RenderPaintCap = 10,
+        RenderPaintBlendMode = 11,
+        RenderBufferRelease = 12,
+        RendererSave = 13,
+        RendererRestore = 14,
+        RendererTransform = 15,
+        RendererDrawPath = 16,
+        RendererClipPath = 17,
+        RendererDrawImage = 18,
+        RendererDrawImageMesh = 19,
+        RendererDrawCommands = 20,
+        FactoryRelease = 21,
+        FactoryMakeRenderPath = 22,
+        FactoryMakeEmptyRenderPath = 23,
+        FactoryMakeRenderPaint = 24,
+        FactoryDecodeImage = 25,
+        SceneFrameReady = 26
+    };
+
+    // Work done at the interop boundary on behalf of a Scene. Must match FrameStats in
+    // RiveSharpInterop.cpp.
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct FrameStats
+    {
+        public const int DelegateCount = (int)ManagedDelegate.SceneFrameReady + 1;
+
+        // Reverse P/Invokes, by ManagedCallKind.
+        public long RenderPathCalls;
+        public long RenderImageCalls;
+        public long RenderPaintCalls;
+        public long RendererCalls;
+        public long FactoryCalls;
+        public long SceneCalls;
+
+        // Verbs sent to managed paths.
+        public long PathVerbs;
+        public long Gradients;
+        public long Images;
+
+        // Vertices handed to Renderer.DrawImageMesh.
+        public long MeshVertices;
+
+        public long AdvanceNanoseconds;
+        public long DrawNanoseconds;
+
+        // The same reverse P/Invokes, by ManagedDelegate. Read through Calls().
+        private fixed long _delegateCalls[DelegateCount];
+
+        // Returns how many times the given delegate was called.
+        public long Calls(ManagedDelegate which)
+        {
+            if ((uint)which >= DelegateCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(which));
+            }
+            fixed (long* calls = _delegateCalls)
+            {
+                return calls[(int)which];
+            }
+        }
+
+        public long ManagedCalls => RenderPathCalls + RenderImageCalls + RenderPaintCalls +
+                                    RendererCalls + FactoryCalls + SceneCalls;
+    }
+
+    // Must match NativeScene::Stats in RiveSharpInterop.cpp.
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SceneStats
+    {
+        // The number of times the Scene has been advanced.
+        public long FrameCount;
+
+        // Everything since the most recent AdvanceAndApply(), including any draws after it.
+        public FrameStats Frame;
+
+        // All frames, including the most recent one.
+        public FrameStats Total;
+    }
+
+    // Process-wide counts of reverse P/Invokes (native calls into managed callbacks), for
+    // benchmarking interop overhead.
+    public static class InteropStats
+    {
+        public static readonly int KindCount = Enum.GetValues(typeof(ManagedCallKind)).Length;
+
+        // Returns the number of calls made for each ManagedCallKind since the last Reset().
+        public static long[] GetCallCounts()
+        {
+            var counts = new long[KindCount];
+            RiveAPI.Interop_GetCallCounts(counts, counts.Length);
+            return counts;
+        }
+
+        public static void Reset() => RiveAPI.Interop_ResetCallCounts();
+    }
+}
@@ -0,0 +1,122 @@
+// Copyright 2022 Rive
+
+using SkiaSharp;
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace RiveSharp
+{
+    // Managed mirrors of the native UV and index buffers that image meshes draw with. These rarely
+    // change after load, so they are copied once per buffer version (UVs already denormalized to
+    // the image), and only the deformed vertex positions cross the interop boundary every frame.
+    internal static class MeshBuffers
+    {
+        static readonly RenderBufferDelegates Delegates = new RenderBufferDelegates
+        {
+            Release = ReleaseCallback
+        };
+
+        static MeshBuffers()
+        {
+            RiveAPI.RenderBuffer_RegisterDelegates(Delegates);
+        }
+
+        // Never modified once published, so a draw on another thread can keep using an entry that
+        // has since been replaced.
+        class Entry
+        {
+            public UInt32 Version;
+            public RenderImage Image;  // The image that UVs were denormalized for.
+            public SKPoint[] UVs;
+            public UInt16[] Indices;
+        }
+
+        // Keyed by native buffer id.
+        static readonly Dictionary<UInt32, Entry> Entries = new Dictionary<UInt32, Entry>();
+
+        // SKVertices.CreateCopy takes its counts from the array lengths, so scratch vertex arrays
+        // are kept per length.
+        [ThreadStatic] static Dictionary<int, SKPoint[]> t_scratchVertices;
+
+        public static SKPoint[] GetUVs(UInt32 id,
+                                       UInt32 version,
+                                       IntPtr uvArray,  // SKPoint[count], normalized
+                                       int count,
+                                       RenderImage image)
+        {
+            lock (Entries)
+            {
+                if (Entries.TryGetValue(id, out var entry) &&
+                    entry.Version == version &&
+                    entry.Image == image)
+                {
+                    return entry.UVs;
+                }
+            }
+            // The local matrix is ignored for SKCanvas.DrawVertices, so we have to manually scale
+            // the UVs to match Skia's convention.
+            var uvs = new SKPoint[count];
+            RiveAPI.CopySKPointArray(uvArray, uvs, count);
+            var scale = new Vector2(image.Width, image.Height);
+            var uvVectors = MemoryMarshal.Cast<SKPoint, Vector2>(uvs.AsSpan());
+            for (int i = 0; i < uvVectors.Length; ++i)
+            {
+                uvVectors[i] *= scale;
+            }
+            lock (Entries)
+            {
+                Entries[id] = new Entry { Version = version, Image = image, UVs = uvs };
+            }
+            return uvs;
+        }
+
+        public static UInt16[] GetIndices(UInt32 id,
+                                          UInt32 version,
+                                          IntPtr indexArray,  // UInt16[count]
+                                          int count)
+        {
+            lock (Entries)
+            {
+                if (Entries.TryGetValue(id, out var entry) && entry.Version == version)
+                {
+                    return entry.Indices;
+                }
+            }
+            var indices = new UInt16[count];
+            RiveAPI.CopyU16Array(indexArray, indices, count);
+            lock (Entries)
+            {
+                Entries[id] = new Entry { Version = version, Indices = indices };
+            }
+            return indices;
+        }
+
+        // Copies the vertex positions into a per-thread array, valid until the next call with the
+        // same count.
+        public static SKPoint[] CopyVertices(IntPtr vertexArray, int count)
+        {
+            if (t_scratchVertices == null)
+            {
+                t_scratchVertices = new Dictionary<int, SKPoint[]>();
+            }
+            if (!t_scratchVertices.TryGetValue(count, out var vertices))
+            {
+                vertices = new SKPoint[count];
+                t_scratchVertices[count] = vertices;
+            }
+            RiveAPI.CopySKPointArray(vertexArray, vertices, count);
+            return vertices;
+        }
+
+        [MonoPInvokeCallback(typeof(RenderBufferDelegates.ReleaseDelegate))]
+        static void ReleaseCallback(UInt32 id)
+        {
+            lock (Entries)
+            {
+                Entries.Remove(id);
+            }
+        }
+    }
+}
@@ -3,6 +3,8 @@
 using SkiaSharp;
 using System;
 using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
 
 namespace RiveSharp
 {
@@ -10,7 +12,6 @@ namespace RiveSharp
     {
         static readonly RenderImageDelegates Delegates = new RenderImageDelegates
         {
-            Release = RiveAPI.ReleaseNativeRefCallback,
             Width = WidthCallback,
             Height = HeightCallback
         };
@@ -20,21 +21,108 @@ namespace RiveSharp
             RiveAPI.RenderImage_RegisterDelegates(Delegates);
         }
 
-        public readonly SKImage SKImage;
-
         public static RenderImage Decode(byte[] data)
         {
             var skimage = SKImage.FromEncodedData(data);
             return skimage != null ? new RenderImage(skimage) : null;
         }
 
+        // Reads the dimensions from the encoded header and returns right away, while the pixels are
+        // decoded on the thread pool. This lets File import hand out every embedded image without
+        // waiting for any of them, and decode them all concurrently in the meantime. Returns null if
+        // the data isn't a recognized image format. Takes ownership of data.
+        internal static RenderImage DecodeAsync(SKData data)
+        {
+            int width, height;
+            using (var codec = SKCodec.Create(data))
+            {
+                if (codec == null)
+                {
+                    data.Dispose();
+                    return null;
+                }
+                width = codec.Info.Width;
+                height = codec.Info.Height;
+                if (codec.EncodedOrigin >= SKEncodedOrigin.LeftTop)
+                {
+                    // The decoded image will be rotated a quarter turn.
+                    int t = width;
+                    width = height;
+                    height = t;
+                }
+            }
+            // FromEncodedData alone defers decoding until the image is first drawn, which would
+            // put it back on the render thread.
+            var decode = Task.Run(() => DecodePixels(data));
+            return new RenderImage(decode, width, height);
+        }
+
+        // Never throws: a failure here would otherwise resurface on the render thread, wrapped in
+        // an AggregateException, the first time the image is drawn.
+        static SKImage DecodePixels(SKData data)
+        {
+            SKImage encoded = null;
+            try
+            {
+                encoded = SKImage.FromEncodedData(data);
+                var raster = encoded?.ToRasterImage(true);
+                if (raster == encoded)
+                {
+                    encoded = null;
+                }
+                return raster;
+            }
+            catch (Exception)
+            {
+                // Corrupt pixel data, or out of memory for the pixels. The image draws as nothing.
+                return null;
+            }
+            finally
+            {
+                encoded?.Dispose();
+                data.Dispose();
+            }
+        }
+
         private RenderImage(SKImage skimage)
         {
-            SKImage = skimage;
+            _skImage = skimage;
+            Width = skimage.Width;
+            Height = skimage.Height;
+        }
+
+        private RenderImage(Task<SKImage> decode, int width, int height)
+        {
+            _decode = decode;
+            Width = width;
+            Height = height;
+        }
+
+        Task<SKImage> _decode;
+        SKImage _skImage;
+
+        // Waits for the image to finish decoding if it hasn't yet. Null if decoding failed.
+        public SKImage SKImage
+        {
+            get
+            {
+                var decode = Volatile.Read(ref _decode);
+                if (decode != null)
+                {
+                    _skImage = decode.Result;
+                    Volatile.Write(ref _decode, null);
+                }
+                return _skImage;
+            }
         }
 
-        public int Width => SKImage.Width;
-        public int Height => SKImage.Height;
+        SKShader _skShader;
+
+        // Image shader for drawing meshes, created on first use.
+        internal SKShader SKShader => _skShader ?? (_skShader = SKImage?.ToShader());
+
+        public int Width { get; }
+        public int Height { get; }
 
         [MonoPInvokeCallback(typeof(RenderImageDelegates.WidthHeightDelegate))]
         static Int32 WidthCallback(IntPtr @ref)
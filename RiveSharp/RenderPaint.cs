@@ -1,6 +1,7 @@
 // Copyright 2022 Rive
 
 using System;
+using System.Collections.Generic;
 using System.ComponentModel;
 using System.Runtime.InteropServices;
 using SkiaSharp;
@@ -51,7 +52,6 @@ namespace RiveSharp
     {
         static readonly RenderPaintDelegates Delegates = new RenderPaintDelegates
         {
-            Release = RiveAPI.ReleaseNativeRefCallback,
             Style = StyleCallback,
             Color = ColorCallback,
             LinearGradient = LinearGradientCallback,
@@ -183,32 +183,52 @@ namespace RiveSharp
             renderPaint.Color = color;
         }
 
+        // Gradients come with the id of their native shader, which is stable for as long as the
+        // gradient's contents don't change, so most frames are just a GradientCache lookup.
         [MonoPInvokeCallback(typeof(RenderPaintDelegates.LinearGradientDelegate))]
-        static void LinearGradientCallback(IntPtr @ref,
-                                           float sx, float sy,
-                                           float ex, float ey,
-                                           IntPtr colorsArray, IntPtr stopsArray, int n)
+        static unsafe void LinearGradientCallback(IntPtr @ref,
+                                                  UInt32 id,
+                                                  float sx, float sy,
+                                                  float ex, float ey,
+                                                  IntPtr colorsArray, IntPtr stopsArray, int n)
         {
             var renderPaint = RiveAPI.CastNativeRef<RenderPaint>(@ref);
-            var colors = new UInt32[n];
-            RiveAPI.CopyU32Array(colorsArray, colors, n);
-            var stops = new float[n];
-            Marshal.Copy(stopsArray, stops, 0, n);
-            renderPaint.LinearGradient(sx, sy, ex, ey, colors, stops);
+            var shader = GradientCache.Find(id);
+            if (shader == null)
+            {
+                var colors = GradientCache.ScratchColors(n);
+                var stops = GradientCache.ScratchStops(n);
+                GradientCache.CopyColorStops(colorsArray, stopsArray, colors, stops);
+                shader = GradientCache.Add(id, SKShader.CreateLinearGradient(new SKPoint(sx, sy),
+                                                                             new SKPoint(ex, ey),
+                                                                             colors,
+                                                                             stops,
+                                                                             SKShaderTileMode.Clamp));
+            }
+            renderPaint.SKPaint.Shader = shader;
         }
 
         [MonoPInvokeCallback(typeof(RenderPaintDelegates.RadialGradientDelegate))]
-        static void RadialGradientCallback(IntPtr @ref,
-                                           float cx, float cy,
-                                           float radius,
-                                           IntPtr colorsArray, IntPtr stopsArray, int n)
+        static unsafe void RadialGradientCallback(IntPtr @ref,
+                                                  UInt32 id,
+                                                  float cx, float cy,
+                                                  float radius,
+                                                  IntPtr colorsArray, IntPtr stopsArray, int n)
         {
             var renderPaint = RiveAPI.CastNativeRef<RenderPaint>(@ref);
-            var colors = new UInt32[n];
-            RiveAPI.CopyU32Array(colorsArray, colors, n);
-            var stops = new float[n];
-            Marshal.Copy(stopsArray, stops, 0, n);
-            renderPaint.RadialGradient(cx, cy, radius, colors, stops);
+            var shader = GradientCache.Find(id);
+            if (shader == null)
+            {
+                var colors = GradientCache.ScratchColors(n);
+                var stops = GradientCache.ScratchStops(n);
+                GradientCache.CopyColorStops(colorsArray, stopsArray, colors, stops);
+                shader = GradientCache.Add(id, SKShader.CreateRadialGradient(new SKPoint(cx, cy),
+                                                                             radius,
+                                                                             colors,
+                                                                             stops,
+                                                                             SKShaderTileMode.Clamp));
+            }
+            renderPaint.SKPaint.Shader = shader;
         }
 
         [MonoPInvokeCallback(typeof(RenderPaintDelegates.ThicknessDelegate))]
@@ -239,4 +259,97 @@ namespace RiveSharp
             renderPaint.BlendMode = (BlendMode)blendMode;
         }
     }
+    // LRU cache of the SKShaders built for native gradients, keyed by the native shader's id.
+    // Callbacks can arrive from several threads at once (e.g. SceneGroup), hence the lock.
+    internal static class GradientCache
+    {
+        const int Capacity = 256;
+        // SKShader.Create*Gradient takes its count from the array lengths, so scratch arrays are
+        // kept per length, up to this many stops.
+        const int MaxScratchLength = 32;
+
+        static readonly Dictionary<UInt32, LinkedListNode<KeyValuePair<UInt32, SKShader>>> Entries =
+            new Dictionary<UInt32, LinkedListNode<KeyValuePair<UInt32, SKShader>>>();
+        static readonly LinkedList<KeyValuePair<UInt32, SKShader>> LRU =
+            new LinkedList<KeyValuePair<UInt32, SKShader>>();  // Most recently used first.
+
+        [ThreadStatic] static SKColor[][] t_scratchColors;
+        [ThreadStatic] static float[][] t_scratchStops;
+
+        public static SKShader Find(UInt32 id)
+        {
+            lock (LRU)
+            {
+                if (!Entries.TryGetValue(id, out var node))
+                {
+                    return null;
+                }
+                LRU.Remove(node);
+                LRU.AddFirst(node);
+                return node.Value.Value;
+            }
+        }
+
+        // Returns the cached shader for id, which is the given one unless another thread got there
+        // first.
+        public static SKShader Add(UInt32 id, SKShader shader)
+        {
+            lock (LRU)
+            {
+                if (Entries.TryGetValue(id, out var existing))
+                {
+                    return existing.Value.Value;
+                }
+                if (Entries.Count >= Capacity)
+                {
+                    // Evicted shaders aren't disposed: paints may still be using them.
+                    Entries.Remove(LRU.Last.Value.Key);
+                    LRU.RemoveLast();
+                }
+                Entries[id] = LRU.AddFirst(new KeyValuePair<UInt32, SKShader>(id, shader));
+                return shader;
+            }
+        }
+
+        public static SKColor[] ScratchColors(int n)
+        {
+            if (n > MaxScratchLength)
+            {
+                return new SKColor[n];
+            }
+            if (t_scratchColors == null)
+            {
+                t_scratchColors = new SKColor[MaxScratchLength + 1][];
+            }
+            return t_scratchColors[n] ?? (t_scratchColors[n] = new SKColor[n]);
+        }
+
+        public static float[] ScratchStops(int n)
+        {
+            if (n > MaxScratchLength)
+            {
+                return new float[n];
+            }
+            if (t_scratchStops == null)
+            {
+                t_scratchStops = new float[MaxScratchLength + 1][];
+            }
+            return t_scratchStops[n] ?? (t_scratchStops[n] = new float[n]);
+        }
+
+        // SKColor has the same layout as a native ColorInt (0xAARRGGBB), so colors copy straight
+        // across.
+        public static unsafe void CopyColorStops(IntPtr colorsArray,
+                                                 IntPtr stopsArray,
+                                                 SKColor[] colors,
+                                                 float[] stops)
+        {
+            fixed (SKColor* dst = colors)
+            {
+                long nBytes = colors.Length * sizeof(UInt32);
+                Buffer.MemoryCopy((void*)colorsArray, dst, nBytes, nBytes);
+            }
+            Marshal.Copy(stopsArray, stops, 0, stops.Length);
+        }
+    }
 }
@@ -17,15 +17,7 @@ namespace RiveSharp
     {
         static readonly RenderPathDelegates Delegates = new RenderPathDelegates
         {
-            Release = RiveAPI.ReleaseNativeRefCallback,
-            Reset = ResetCallback,
-            AddRenderPath = AddRenderPathCallback,
-            FillRule = FillRuleCallback,
-            MoveTo = MoveToCallback,
-            LineTo = LineToCallback,
-            QuadTo = QuadToCallback,
-            CubicTo = CubicToCallback,
-            Close = CloseCallback
+            Commit = CommitCallback
         };
 
         static RenderPath()
@@ -45,15 +37,24 @@ namespace RiveSharp
             throw new InvalidEnumArgumentException("Invalid FillRule " + rule);
         }
 
-        public RenderPath(SKPoint[] pts, byte[] verbs, FillRule fillRule)
+        public unsafe RenderPath(SKPoint[] pts, byte[] verbs, FillRule fillRule)
         {
             SKPath.FillType = ToSKPathFillType(fillRule);
+            fixed (SKPoint* ptsPtr = pts)
+            fixed (byte* verbsPtr = verbs)
+            {
+                AddVerbs(ptsPtr, pts.Length, verbsPtr, verbs.Length);
+            }
+        }
 
+        // Appends the given verbs and points to SKPath.
+        private unsafe void AddVerbs(SKPoint* pts, int nPts, byte* verbs, int nVerbs)
+        {
             // Unfortuately, SkiaSharp doesn't appear to expose the SkPathBuilder API yet.
             int ptsIdx = 0;
-            foreach (byte v in verbs)
+            for (int i = 0; i < nVerbs; ++i)
             {
-                switch ((SKPathVerb)v)
+                switch ((SKPathVerb)verbs[i])
                 {
                     case SKPathVerb.Move:
                         SKPath.MoveTo(pts[ptsIdx]);
@@ -78,12 +79,20 @@ namespace RiveSharp
                         throw new Exception("invalid path verb");
                 }
             }
-            if (ptsIdx != pts.Length)
+            if (ptsIdx != nPts)
             {
                 throw new Exception("invalid number of points");
             }
         }
 
+        // Replaces the contents of SKPath with geometry accumulated on the native side.
+        internal unsafe void Commit(SKPoint* pts, int nPts, byte* verbs, int nVerbs, FillRule fillRule)
+        {
+            SKPath.Rewind();
+            SKPath.FillType = ToSKPathFillType(fillRule);
+            AddVerbs(pts, nPts, verbs, nVerbs);
+        }
+
         public RenderPath() { }
 
         public void Reset() { SKPath.Reset(); }
@@ -105,65 +114,16 @@ namespace RiveSharp
         }
         public void Close() { SKPath.Close(); }
 
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.ResetDelegate))]
-        static void ResetCallback(IntPtr @ref)
-        {
-            var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            renderPath.Reset();
-        }
-
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.AddRenderPathDelegate))]
-        static void AddRenderPathCallback(IntPtr @ref,
-                                          IntPtr pathRef,
-                                          float x1, float y1,
-                                          float x2, float y2,
-                                          float tx, float ty)
-        {
-            var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            var path = RiveAPI.CastNativeRef<RenderPath>(pathRef);
-            renderPath.AddRenderPath(path, new Mat2D(x1, y1, x2, y2, tx, ty));
-        }
-
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.FillRuleDelegate))]
-        static void FillRuleCallback(IntPtr @ref, int rule)
-        {
-            var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            renderPath.FillRule = (FillRule)rule;
-        }
-
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.MoveToDelegate))]
-        static void MoveToCallback(IntPtr @ref, float x, float y)
-        {
-            var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            renderPath.MoveTo(x, y);
-        }
-
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.LineToDelegate))]
-        static void LineToCallback(IntPtr @ref, float x, float y)
-        {
-            var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            renderPath.LineTo(x, y);
-        }
-
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.QuadToDelegate))]
-        static void QuadToCallback(IntPtr @ref, float ox, float oy, float x, float y)
-        {
-            var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            renderPath.QuadTo(ox, oy, x, y);
-        }
-
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.CubicToDelegate))]
-        static void CubicToCallback(IntPtr @ref, float ox, float oy, float ix, float iy, float x, float y)
-        {
-            var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            renderPath.CubicTo(ox, oy, ix, iy, x, y);
-        }
-
-        [MonoPInvokeCallback(typeof(RenderPathDelegates.CloseDelegate))]
-        static void CloseCallback(IntPtr @ref)
+        [MonoPInvokeCallback(typeof(RenderPathDelegates.CommitDelegate))]
+        static unsafe void CommitCallback(IntPtr @ref,
+                                          IntPtr ptsArray,  // SKPoint[nPts]
+                                          int nPts,
+                                          IntPtr verbsArray,  // byte[nVerbs]
+                                          int nVerbs,
+                                          int fillRule)
         {
             var renderPath = RiveAPI.CastNativeRef<RenderPath>(@ref);
-            renderPath.Close();
+            renderPath.Commit((SKPoint*)ptsArray, nPts, (byte*)verbsArray, nVerbs, (FillRule)fillRule);
         }
     }
 }
@@ -40,6 +40,19 @@ namespace RiveSharp
     }
 
 
+    // Opcodes of the native RenderCommandBuffer. See RiveSharpInterop.cpp for the layouts.
+    internal enum RenderCommand
+    {
+        Save = 0,
+        Restore = 1,
+        Transform = 2,
+        DrawPath = 3,
+        ClipPath = 4,
+        DrawImage = 5,
+        DrawImageMesh = 6,
+        CommitPath = 7
+    }
+
     public class Renderer
     {
         static readonly RendererDelegates Delegates = new RendererDelegates
@@ -50,7 +63,8 @@ namespace RiveSharp
             DrawPath = DrawPathCallback,
             ClipPath = ClipPathCallback,
             DrawImage = DrawImageCallback,
-            DrawImageMesh = DrawImageMeshCallback
+            DrawImageMesh = DrawImageMeshCallback,
+            DrawCommands = DrawCommandsCallback
         };
 
         static Renderer()
@@ -58,25 +72,66 @@ namespace RiveSharp
             RiveAPI.Renderer_RegisterDelegates(Delegates);
         }
 
-        public static unsafe Mat2D ComputeAlignment(Fit fit,
-                                                    Alignment alignment,
-                                                    AABB frame,
-                                                    AABB content)
+        // A managed port of rive::computeAlignment, with identical float operations so it matches
+        // bit-for-bit, given a rive built without FMA contraction (see Mat2D).
+        public static Mat2D ComputeAlignment(Fit fit, Alignment alignment, AABB frame, AABB content)
         {
-            var args = new RiveAPI.ComputeAlignmentArgs
+            float contentWidth = content.MaxX - content.MinX;
+            float contentHeight = content.MaxY - content.MinY;
+            float x = -content.MinX - contentWidth * 0.5f - (alignment.X * contentWidth * 0.5f);
+            float y = -content.MinY - contentHeight * 0.5f - (alignment.Y * contentHeight * 0.5f);
+
+            float frameWidth = frame.MaxX - frame.MinX;
+            float frameHeight = frame.MaxY - frame.MinY;
+            float scaleX = 1, scaleY = 1;
+            switch (fit)
             {
-                Fit = (int)fit,
-                AlignX = alignment.X,
-                AlignY = alignment.Y,
-                Frame = frame,
-                Content = content
-            };
-            RiveAPI.Renderer_ComputeAlignment(&args);
-            return args.Matrix;
+                case Fit.Fill:
+                    scaleX = frameWidth / contentWidth;
+                    scaleY = frameHeight / contentHeight;
+                    break;
+                case Fit.Contain:
+                    scaleX = scaleY = FMin(frameWidth / contentWidth, frameHeight / contentHeight);
+                    break;
+                case Fit.Cover:
+                    scaleX = scaleY = FMax(frameWidth / contentWidth, frameHeight / contentHeight);
+                    break;
+                case Fit.FitHeight:
+                    scaleX = scaleY = frameHeight / contentHeight;
+                    break;
+                case Fit.FitWidth:
+                    scaleX = scaleY = frameWidth / contentWidth;
+                    break;
+                case Fit.None:
+                    break;
+                case Fit.ScaleDown:
+                    float minScale = FMin(frameWidth / contentWidth, frameHeight / contentHeight);
+                    scaleX = scaleY = minScale < 1 ? minScale : 1;
+                    break;
+            }
+
+            var translation = Mat2D.FromTranslate(
+                frame.MinX + frameWidth * 0.5f + (alignment.X * frameWidth * 0.5f),
+                frame.MinY + frameHeight * 0.5f + (alignment.Y * frameHeight * 0.5f));
+            return translation * Mat2D.FromScale(scaleX, scaleY) * Mat2D.FromTranslate(x, y);
+        }
+
+        // std::fmin/fmax, which (unlike Math.Min/Max) return the other argument if one is NaN.
+        static float FMin(float a, float b)
+        {
+            return float.IsNaN(a) ? b : float.IsNaN(b) ? a : (a < b ? a : b);
+        }
+
+        static float FMax(float a, float b)
+        {
+            return float.IsNaN(a) ? b : float.IsNaN(b) ? a : (a > b ? a : b);
         }
 
         public readonly SKCanvas SKCanvas;
 
+        // Reused by every DrawImageMesh, which happens for every mesh on every frame.
+        readonly SKPaint _meshPaint = new SKPaint { IsAntialias = false };
+
         public Renderer(SKCanvas skCanvas)
         {
             SKCanvas = skCanvas;
@@ -103,6 +158,10 @@ namespace RiveSharp
 
         public void DrawImage(RenderImage image, BlendMode blendMode, float opacity)
         {
+            if (image.SKImage == null)
+            {
+                return;
+            }
             SKCanvas.DrawImage(image.SKImage, 0, 0, new SKPaint
             {
                 IsAntialias = true,
@@ -121,19 +180,23 @@ namespace RiveSharp
             {
                 throw new ArgumentException("uvs must be the same length as vertices.");
             }
-            var skVertices = SKVertices.CreateCopy(SKVertexMode.Triangles,
-                                                   positions: vertices,
-                                                   texs: uvs,
-                                                   colors: null,
-                                                   indices: indices);
-            // DrawVertices ignores the blend mode if we don't have colors && uvs.
-            SKCanvas.DrawVertices(skVertices, SKBlendMode.Dst, new SKPaint
+            if (image.SKShader == null)
             {
-                IsAntialias = false,  // DrawVertices ignores the IsAntialias flag.
-                ColorF = new SKColorF(1, 1, 1, opacity),
-                Shader = image.SKImage.ToShader(),
-                BlendMode = RenderPaint.ToSKBlendMode(blendMode),
-            });
+                return;
+            }
+            using (var skVertices = SKVertices.CreateCopy(SKVertexMode.Triangles,
+                                                          positions: vertices,
+                                                          texs: uvs,
+                                                          colors: null,
+                                                          indices: indices))
+            {
+                // DrawVertices ignores the IsAntialias flag, and ignores the blend mode if we
+                // don't have colors && uvs.
+                _meshPaint.ColorF = new SKColorF(1, 1, 1, opacity);
+                _meshPaint.Shader = image.SKShader;
+                _meshPaint.BlendMode = RenderPaint.ToSKBlendMode(blendMode);
+                SKCanvas.DrawVertices(skVertices, SKBlendMode.Dst, _meshPaint);
+            }
         }
 
         // Transformation helpers.
@@ -198,22 +261,107 @@ namespace RiveSharp
         static void DrawImageMeshCallback(IntPtr @ref,
                                           IntPtr imageRef,
                                           IntPtr vertexArray,  // SKPoint[nVertices]
-                                          IntPtr uvArray,  // SKPoint[nVertices]
+                                          IntPtr uvArray,  // SKPoint[nVertices], normalized
+                                          UInt32 uvBufferID,
+                                          UInt32 uvBufferVersion,
                                           Int32 nVertices,
                                           IntPtr indexArray,  // UInt16[nIndices]
+                                          UInt32 indexBufferID,
+                                          UInt32 indexBufferVersion,
                                           Int32 nIndices,
                                           Int32 blendMode,
                                           float opacity)
         {
             var renderer = RiveAPI.CastNativeRef<Renderer>(@ref);
             var image = RiveAPI.CastNativeRef<RenderImage>(imageRef);
-            var vertices = new SKPoint[nVertices];
-            RiveAPI.CopySKPointArray(vertexArray, vertices, nVertices);
-            var uvs = new SKPoint[nVertices];
-            RiveAPI.CopySKPointArray(uvArray, uvs, nVertices);
-            var indices = new UInt16[nIndices];
-            RiveAPI.CopyU16Array(indexArray, indices, nIndices);
+            var vertices = MeshBuffers.CopyVertices(vertexArray, nVertices);
+            var uvs = MeshBuffers.GetUVs(uvBufferID, uvBufferVersion, uvArray, nVertices, image);
+            var indices = MeshBuffers.GetIndices(indexBufferID,
+                                                 indexBufferVersion,
+                                                 indexArray,
+                                                 nIndices);
             renderer.DrawImageMesh(image, vertices, uvs, indices, (BlendMode)blendMode, opacity);
         }
+
+        // Native handles are always encoded as 64 bits in the command buffer.
+        static unsafe IntPtr ReadCommandRef(byte* p) => new IntPtr(*(long*)p);
+
+        // Replays a frame recorded by the native RecordingRenderer.
+        [MonoPInvokeCallback(typeof(RendererDelegates.DrawCommandsDelegate))]
+        static unsafe void DrawCommandsCallback(IntPtr @ref, IntPtr commands, Int32 nBytes)
+        {
+            var renderer = RiveAPI.CastNativeRef<Renderer>(@ref);
+            byte* p = (byte*)commands;
+            byte* end = p + nBytes;
+            while (p < end)
+            {
+                switch ((RenderCommand)(*(int*)p))
+                {
+                    case RenderCommand.Save:
+                        renderer.Save();
+                        p += 8;
+                        break;
+                    case RenderCommand.Restore:
+                        renderer.Restore();
+                        p += 8;
+                        break;
+                    case RenderCommand.Transform:
+                    {
+                        float* m = (float*)(p + 8);
+                        renderer.Transform(new Mat2D(m[0], m[1], m[2], m[3], m[4], m[5]));
+                        p += 32;
+                        break;
+                    }
+                    case RenderCommand.DrawPath:
+                        renderer.DrawPath(RiveAPI.CastNativeRef<RenderPath>(ReadCommandRef(p + 8)),
+                                          RiveAPI.CastNativeRef<RenderPaint>(ReadCommandRef(p + 16)));
+                        p += 24;
+                        break;
+                    case RenderCommand.ClipPath:
+                        renderer.ClipPath(RiveAPI.CastNativeRef<RenderPath>(ReadCommandRef(p + 8)));
+                        p += 16;
+                        break;
+                    case RenderCommand.DrawImage:
+                        renderer.DrawImage(RiveAPI.CastNativeRef<RenderImage>(ReadCommandRef(p + 8)),
+                                           (BlendMode)(*(int*)(p + 4)),
+                                           *(float*)(p + 16));
+                        p += 24;
+                        break;
+                    case RenderCommand.DrawImageMesh:
+                    {
+                        int nVertices = *(int*)(p + 40);
+                        int nIndices = *(int*)(p + 44);
+                        DrawImageMeshCallback(@ref,
+                                              ReadCommandRef(p + 8),
+                                              ReadCommandRef(p + 16),
+                                              ReadCommandRef(p + 24),
+                                              *(UInt32*)(p + 48),
+                                              *(UInt32*)(p + 52),
+                                              nVertices,
+                                              ReadCommandRef(p + 32),
+                                              *(UInt32*)(p + 56),
+                                              *(UInt32*)(p + 60),
+                                              nIndices,
+                                              *(int*)(p + 4),
+                                              *(float*)(p + 64));
+                        p += 72;
+                        break;
+                    }
+                    case RenderCommand.CommitPath:
+                    {
+                        var path = RiveAPI.CastNativeRef<RenderPath>(ReadCommandRef(p + 8));
+                        path.Commit((SKPoint*)ReadCommandRef(p + 16),
+                                    *(int*)(p + 32),
+                                    (byte*)ReadCommandRef(p + 24),
+                                    *(int*)(p + 36),
+                                    (FillRule)(*(int*)(p + 4)));
+                        p += 40;
+                        break;
+                    }
+                    default:
+                        throw new Exception("invalid render command");
+                }
+            }
+        }
     }
 }
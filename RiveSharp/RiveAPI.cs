@@ -34,52 +34,50 @@ namespace RiveSharp
         public static extern void CopyU16Array(IntPtr sourceArray, [Out] UInt16[] destination, Int32 count);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern unsafe void Mat2D_Multiply(Mat2D a, Mat2D b, Mat2D* c);
+        public static extern void Factory_RegisterDelegates(FactoryDelegates delegates);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern unsafe void Mat2D_MultiplyVec2D(Mat2D a, Vec2D b, Vec2D* c);
+        public static extern void Renderer_RegisterDelegates(RendererDelegates delegates);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern unsafe SByte Mat2D_Invert(Mat2D a, Mat2D* b);
+        public static extern void RenderBuffer_RegisterDelegates(RenderBufferDelegates delegates);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern void Factory_RegisterDelegates(FactoryDelegates delegates);
+        public static extern void RenderImage_RegisterDelegates(RenderImageDelegates delegates);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern void Renderer_RegisterDelegates(RendererDelegates delegates);
+        public static extern void RenderPaint_RegisterDelegates(RenderPaintDelegates delegates);
 
-        [StructLayout(LayoutKind.Sequential)]
-        public struct ComputeAlignmentArgs
-        {
-            public Int32 Fit;
-            public float AlignX;
-            public float AlignY;
-            public AABB Frame;
-            public AABB Content;
-            public Mat2D Matrix;
-        }
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void RenderPath_RegisterDelegates(RenderPathDelegates delegates);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static unsafe extern void Renderer_ComputeAlignment(ComputeAlignmentArgs* args);
+        public static extern IntPtr RiveFile_Load(IntPtr factoryPtr, IntPtr fileBytes, int length);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern void RenderImage_RegisterDelegates(RenderImageDelegates delegates);
+        public static extern IntPtr RiveFile_LoadSoftware(IntPtr fileBytes, int length);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern void RenderPaint_RegisterDelegates(RenderPaintDelegates delegates);
+        public static extern void RiveFile_Release(IntPtr file);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
-        public static extern void RenderPath_RegisterDelegates(RenderPathDelegates delegates);
+        public static extern void Scene_RegisterDelegates(SceneDelegates delegates);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr Scene_New(IntPtr factoryPtr);
 
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr Scene_NewSoftware();
+
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Scene_Delete(IntPtr scene);
 
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern SByte Scene_LoadFile(IntPtr scene, [In] byte[] fileBytes, int length);
 
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_LoadFromFile(IntPtr scene, IntPtr file);
+
         [DllImport(Library, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.Cdecl)]
         public static extern SByte Scene_LoadArtboard(IntPtr scene, string name);
 
@@ -98,6 +96,23 @@ namespace RiveSharp
         [DllImport(Library, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.Cdecl)]
         public static extern SByte Scene_FireTrigger(IntPtr scene, string name);
 
+        [DllImport(Library, CharSet = CharSet.Ansi, CallingConvention = CallingConvention.Cdecl)]
+        public static extern Int32 Scene_InputHandle(IntPtr scene, string name);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_SetBoolAt(IntPtr scene, Int32 handle, Int32 value);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_SetNumberAt(IntPtr scene, Int32 handle, float value);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_FireTriggerAt(IntPtr scene, Int32 handle);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern Int32 Scene_SetInputs(IntPtr scene,
+                                                   [In] StateMachineInputValue[] values,
+                                                   Int32 count);
+
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern Single Scene_Width(IntPtr scene);
 
@@ -119,9 +134,71 @@ namespace RiveSharp
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern SByte Scene_AdvanceAndApply(IntPtr scene, float elapsedSeconds);
 
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_SeekTo(IntPtr scene, float seconds);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_GetDirtyBounds(IntPtr scene, out AABB bounds);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern Int32 Scene_Snapshot(IntPtr scene, [Out] byte[] buffer, Int32 capacity);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_Restore(IntPtr scene, [In] byte[] snapshot, Int32 length);
+
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Scene_Draw(IntPtr scene, IntPtr renderer);
 
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Scene_DrawBatched(IntPtr scene, IntPtr renderer);
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct AtlasEntry
+        {
+            public IntPtr Scene;
+            public AABB Frame;
+            public Int32 Fit;
+            public float AlignX;
+            public float AlignY;
+        }
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern Int32 Scene_DrawAtlas(IntPtr renderer,
+                                                   [In] AtlasEntry[] entries,
+                                                   Int32 count,
+                                                   AABB viewport);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte Scene_DrawSoftware(IntPtr scene,
+                                                      IntPtr pixels,
+                                                      Int32 width,
+                                                      Int32 height,
+                                                      Int32 rowBytes,
+                                                      Mat2D transform);
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct RenderSequenceArgs
+        {
+            public float StartSeconds;
+            public float Fps;
+            public Int32 FrameCount;
+            public Int32 Width;
+            public Int32 Height;
+            public Int32 RowBytes;
+            public Mat2D Transform;
+            public UInt32 ClearColor;
+            public Int32 SurfaceCount;
+            public IntPtr Surfaces;  // byte*[SurfaceCount]
+            public IntPtr FrameSink;
+        }
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static unsafe extern Int32 Scene_RenderSequence(IntPtr scene,
+                                                               RenderSequenceArgs* args);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern unsafe void Scene_GetStats(IntPtr scene, SceneStats* stats);
+
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Scene_PointerDown(IntPtr scene, Vec2D pos);
 
@@ -131,14 +208,58 @@ namespace RiveSharp
         [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
         public static extern void Scene_PointerUp(IntPtr scene, Vec2D pos);
 
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Scene_SetPointerTransform(IntPtr scene, Mat2D viewToArtboard);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Scene_QueuePointerEvent(IntPtr scene,
+                                                          Int32 type,
+                                                          Vec2D viewPosition);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr SceneGroup_New();
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SceneGroup_Delete(IntPtr group);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern SByte SceneGroup_Add(IntPtr group, IntPtr scene);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SceneGroup_Remove(IntPtr group, IntPtr scene);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern Int32 SceneGroup_AdvanceAll(IntPtr group,
+                                                         float elapsedSeconds,
+                                                         [Out] byte[] needsRedraw);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern Int32 Interop_GetCallCounts([Out] Int64[] counts, Int32 maxCount);
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Interop_ResetCallCounts();
+
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Interop_RegisterDelegates(InteropDelegates delegates);
+
+        // Hands the refs of destroyed native wrappers back to HandleTable. Exports that destroy
+        // wrappers do this on their own; this is for anything that slips between them.
+        [DllImport(Library, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void Interop_FlushReleases();
+
         public static IntPtr CreateNativeRef(Object obj)
         {
-            return GCHandle.ToIntPtr(GCHandle.Alloc(obj));
+            return HandleTable.Alloc(obj);
         }
 
         public static T CastNativeRef<T>(IntPtr @ref)
         {
-            return (T)GCHandle.FromIntPtr(@ref).Target;
+            return (T)HandleTable.Get(@ref);
+        }
+
+        public static void ReleaseNativeRef(IntPtr @ref)
+        {
+            HandleTable.Free(@ref);
         }
 
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
@@ -147,10 +268,19 @@ namespace RiveSharp
         [MonoPInvokeCallback(typeof(ReleaseNativeRefDelegate))]
         public static void ReleaseNativeRefCallback(IntPtr @ref)
         {
-            GCHandle.FromIntPtr(@ref).Free();
+            HandleTable.Free(@ref);
         }
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal unsafe struct InteropDelegates
+    {
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public unsafe delegate void ReleaseRefsDelegate(IntPtr refsArray,  // IntPtr[count]
+                                                        Int32 count);
+        public ReleaseRefsDelegate ReleaseRefs;
+    }
+
     [StructLayout(LayoutKind.Sequential)]
     internal unsafe struct FactoryDelegates
     {
@@ -213,19 +343,35 @@ namespace RiveSharp
                                                           IntPtr imageRef,
                                                           IntPtr vertexArray,  // SKPoint[nVertices]
                                                           IntPtr uvArray,  // SKPoint[nVertices]
+                                                          UInt32 uvBufferID,
+                                                          UInt32 uvBufferVersion,
                                                           Int32 nVertices,
                                                           IntPtr indexArray,  // UInt16[nIndices]
+                                                          UInt32 indexBufferID,
+                                                          UInt32 indexBufferVersion,
                                                           Int32 nIndices,
                                                           Int32 blendMode,
                                                           float opacity);
         public DrawImageMeshDelegate DrawImageMesh;
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public unsafe delegate void DrawCommandsDelegate(IntPtr @ref,
+                                                         IntPtr commands,  // byte[nBytes]
+                                                         Int32 nBytes);
+        public DrawCommandsDelegate DrawCommands;
     }
 
     [StructLayout(LayoutKind.Sequential)]
-    internal unsafe struct RenderImageDelegates
+    internal unsafe struct RenderBufferDelegates
     {
-        public RiveAPI.ReleaseNativeRefDelegate Release;
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        public unsafe delegate void ReleaseDelegate(UInt32 id);
+        public ReleaseDelegate Release;
+    }
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal unsafe struct RenderImageDelegates
+    {
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public unsafe delegate Int32 WidthHeightDelegate(IntPtr @ref);
         public WidthHeightDelegate Width;
@@ -235,8 +381,6 @@ namespace RiveSharp
     [StructLayout(LayoutKind.Sequential)]
     internal unsafe struct RenderPaintDelegates
     {
-        public RiveAPI.ReleaseNativeRefDelegate Release;
-
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public unsafe delegate void StyleDelegate(IntPtr @ref, Int32 style);
         public StyleDelegate Style;
@@ -247,6 +391,7 @@ namespace RiveSharp
 
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public unsafe delegate void LinearGradientDelegate(IntPtr @ref,
+                                                           UInt32 id,
                                                            float sx, float sy,
                                                            float ex, float ey,
                                                            IntPtr colorsArray,  // UInt32[n]
@@ -256,6 +401,7 @@ namespace RiveSharp
 
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         public unsafe delegate void RadialGradientDelegate(IntPtr @ref,
+                                                           UInt32 id,
                                                            float cx, float cy,
                                                            float radius,
                                                            IntPtr colorsArray,  // UInt32[n]
@@ -281,49 +427,23 @@ namespace RiveSharp
     }
 
     [StructLayout(LayoutKind.Sequential)]
-    internal unsafe struct RenderPathDelegates
+    internal unsafe struct SceneDelegates
     {
-        public RiveAPI.ReleaseNativeRefDelegate Release;
-
-        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void ResetDelegate(IntPtr ptr);
-        public ResetDelegate Reset;
-
-        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void AddRenderPathDelegate(IntPtr ptr,
-                                                          IntPtr path,
-                                                          float x1, float y1,
-                                                          float x2, float y2,
-                                                          float tx, float ty);
-        public AddRenderPathDelegate AddRenderPath;
-
-        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void FillRuleDelegate(IntPtr ptr, int rule);
-        public FillRuleDelegate FillRule;
-
-        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void MoveToDelegate(IntPtr ptr, float x, float y);
-        public MoveToDelegate MoveTo;
-
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void LineToDelegate(IntPtr ptr, float x, float y);
-        public LineToDelegate LineTo;
-
-        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void QuadToDelegate(IntPtr ptr,
-                                                   float os, float oy,
-                                                   float x, float y);
-        public QuadToDelegate QuadTo;
-
-        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void CubicToDelegate(IntPtr ptr,
-                                                    float ox, float oy,
-                                                    float ix, float iy,
-                                                    float x, float y);
-        public CubicToDelegate CubicTo;
+        public unsafe delegate Int32 FrameReadyDelegate(IntPtr sink, Int32 frame, Int32 surface);
+        public FrameReadyDelegate FrameReady;
+    }
 
+    [StructLayout(LayoutKind.Sequential)]
+    internal unsafe struct RenderPathDelegates
+    {
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        public unsafe delegate void CloseDelegate(IntPtr ptr);
-        public CloseDelegate Close;
+        public unsafe delegate void CommitDelegate(IntPtr ptr,
+                                                   IntPtr ptsArray,  // SKPoint[nPts]
+                                                   Int32 nPts,
+                                                   IntPtr verbsArray,  // byte[nVerbs]
+                                                   Int32 nVerbs,
+                                                   Int32 fillRule);
+        public CommitDelegate Commit;
     }
 }
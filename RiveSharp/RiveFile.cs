@@ -0,0 +1,208 @@
+// Copyright 2022 Rive
+
+using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+
+namespace RiveSharp
+{
+    // A parsed .riv file that can be shared by any number of Scenes. Files are cached natively by
+    // content, so loading the same bytes again returns the already-imported file (along with its
+    // decoded images) instead of parsing it a second time.
+    public class RiveFile : IDisposable
+    {
+        private IntPtr _nativePtr;
+        public IntPtr NativePtr => _nativePtr;
+
+        private RiveFile(IntPtr nativePtr)
+        {
+            _nativePtr = nativePtr;
+        }
+
+        ~RiveFile()
+        {
+            Release();
+        }
+
+        // Returns null if the data is not a valid .riv file, or if it has images and backend is
+        // Software (which can't draw them). The array is pinned for the duration of the import
+        // rather than copied.
+        //
+        // A file can only be loaded into Scenes of the same RenderBackend it was loaded for.
+        public static RiveFile Load(byte[] data, RenderBackend backend = RenderBackend.Managed)
+        {
+            if (data == null)
+            {
+                return null;
+            }
+            return Load(new ArraySegment<byte>(data), backend);
+        }
+
+        public static unsafe RiveFile Load(ArraySegment<byte> data,
+                                           RenderBackend backend = RenderBackend.Managed)
+        {
+            if (data.Array == null || data.Count == 0)
+            {
+                return null;
+            }
+            fixed (byte* bytes = &data.Array[data.Offset])
+            {
+                return Load((IntPtr)bytes, data.Count, backend);
+            }
+        }
+
+        public static unsafe RiveFile Load(ReadOnlySpan<byte> data,
+                                           RenderBackend backend = RenderBackend.Managed)
+        {
+            fixed (byte* bytes = data)
+            {
+                return Load((IntPtr)bytes, data.Length, backend);
+            }
+        }
+
+        // Imports directly from unmanaged memory without copying it first. File::import copies
+        // everything it keeps, so the memory only needs to stay valid until this call returns.
+        public static RiveFile Load(IntPtr data,
+                                    int length,
+                                    RenderBackend backend = RenderBackend.Managed)
+        {
+            if (data == IntPtr.Zero || length <= 0)
+            {
+                return null;
+            }
+            var nativePtr = backend == RenderBackend.Software
+                ? RiveAPI.RiveFile_LoadSoftware(data, length)
+                : RiveAPI.RiveFile_Load(RiveAPI.CreateNativeRef(Factory.Instance), data, length);
+            return nativePtr != IntPtr.Zero ? new RiveFile(nativePtr) : null;
+        }
+
+        // Avoids an intermediate copy for memory and file streams. Other streams are read into a
+        // temporary buffer. Either way, the stream is left positioned at its end.
+        public static RiveFile Load(Stream stream, RenderBackend backend = RenderBackend.Managed)
+        {
+            if (stream is MemoryStream memoryStream && memoryStream.TryGetBuffer(out var buffer))
+            {
+                int position = (int)memoryStream.Position;
+                memoryStream.Position = memoryStream.Length;
+                return Load(new ArraySegment<byte>(buffer.Array,
+                                                   buffer.Offset + position,
+                                                   buffer.Count - position),
+                            backend);
+            }
+            if (stream is FileStream fileStream &&
+                TryLoadMapped(fileStream, backend, out RiveFile mapped))
+            {
+                return mapped;
+            }
+            var data = new byte[stream.Length - stream.Position];
+            int offset = 0;
+            while (offset < data.Length)
+            {
+                int n = stream.Read(data, offset, data.Length - offset);
+                if (n <= 0)
+                {
+                    break;
+                }
+                offset += n;
+            }
+            return Load(new ArraySegment<byte>(data, 0, offset), backend);
+        }
+
+        // Imports a .riv file straight out of a read-only memory mapping of the file at path.
+        public static RiveFile LoadMapped(string path,
+                                          RenderBackend backend = RenderBackend.Managed)
+        {
+            long length = new FileInfo(path).Length;
+            if (length == 0 || length > int.MaxValue)
+            {
+                return null;
+            }
+            using (var mappedFile = MemoryMappedFile.CreateFromFile(path,
+                                                                    FileMode.Open,
+                                                                    null,
+                                                                    0,
+                                                                    MemoryMappedFileAccess.Read))
+            {
+                return LoadMapped(mappedFile, 0, length, backend);
+            }
+        }
+
+        // Maps the rest of the caller's own stream, through its handle, so it works no matter how
+        // the file was opened or shared. Returns false, with the stream untouched, if the stream
+        // can't be mapped; the caller reads it instead.
+        private static bool TryLoadMapped(FileStream fileStream,
+                                          RenderBackend backend,
+                                          out RiveFile file)
+        {
+            file = null;
+            long position = fileStream.Position;
+            long length = fileStream.Length - position;
+            if (length <= 0 || length > int.MaxValue)
+            {
+                return false;
+            }
+            MemoryMappedFile mappedFile;
+            try
+            {
+                mappedFile = MemoryMappedFile.CreateFromFile(fileStream,
+                                                             null,
+                                                             0,
+                                                             MemoryMappedFileAccess.Read,
+                                                             HandleInheritability.None,
+                                                             leaveOpen: true);
+            }
+            catch (Exception e) when (e is IOException ||
+                                      e is UnauthorizedAccessException ||
+                                      e is NotSupportedException)
+            {
+                return false;
+            }
+            using (mappedFile)
+            {
+                file = LoadMapped(mappedFile, position, length, backend);
+            }
+            fileStream.Position = position + length;
+            return true;
+        }
+
+        private static unsafe RiveFile LoadMapped(MemoryMappedFile mappedFile,
+                                                  long offset,
+                                                  long length,
+                                                  RenderBackend backend)
+        {
+            using (var view = mappedFile.CreateViewAccessor(offset,
+                                                            length,
+                                                            MemoryMappedFileAccess.Read))
+            {
+                var handle = view.SafeMemoryMappedViewHandle;
+                byte* bytes = null;
+                handle.AcquirePointer(ref bytes);
+                try
+                {
+                    return Load((IntPtr)(bytes + view.PointerOffset), (int)length, backend);
+                }
+                finally
+                {
+                    handle.ReleasePointer();
+                }
+            }
+        }
+
+        // Drops this reference to the native file. Scenes that were loaded from it keep it alive
+        // for as long as they need it.
+        public void Dispose()
+        {
+            Release();
+            GC.SuppressFinalize(this);
+        }
+
+        private void Release()
+        {
+            if (_nativePtr != IntPtr.Zero)
+            {
+                RiveAPI.RiveFile_Release(_nativePtr);
+                _nativePtr = IntPtr.Zero;
+            }
+        }
+    }
+}
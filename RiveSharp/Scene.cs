@@ -19,13 +19,82 @@ namespace RiveSharp
         PingPong = 2
     };
 
+    public enum RenderBackend
+    {
+        // Draws through a managed Renderer (SkiaSharp).
+        Managed = 0,
+
+        // Rasterizes natively on the CPU into a pixel buffer, with no managed callbacks. For
+        // headless rendering. It has no image decoder, so files with images fail to load.
+        Software = 1
+    };
+
+    public enum PointerEventType
+    {
+        Down = 0,
+        Move = 1,
+        Up = 2
+    };
+
+    // A (handle, value) pair for Scene.SetInputs. Bools are set to (Value != 0), and triggers fire
+    // if Value != 0.
+    [StructLayout(LayoutKind.Sequential)]
+    public struct StateMachineInputValue
+    {
+        public Int32 Handle;
+        public float Value;
+
+        public StateMachineInputValue(int handle, float value)
+        {
+            Handle = handle;
+            Value = value;
+        }
+    }
+
+    // A scene and the frame to align it into, for Scene.DrawAtlas.
+    public struct AtlasCell
+    {
+        public Scene Scene;
+        public AABB Frame;
+        public Fit Fit;
+        public Alignment Alignment;
+
+        public AtlasCell(Scene scene, AABB frame, Fit fit, Alignment alignment)
+        {
+            Scene = scene;
+            Frame = frame;
+            Fit = fit;
+            Alignment = alignment;
+        }
+    }
+
+    // Receives each frame of Scene.RenderSequence. The pixels are only valid until the handler
+    // returns, after which their buffer may be reused for a later frame. Return false to stop.
+    public delegate bool SequenceFrameHandler(int frameIndex, byte[] pixels);
+
     public class Scene
     {
+        static readonly SceneDelegates Delegates = new SceneDelegates
+        {
+            FrameReady = FrameReadyCallback
+        };
+
+        static Scene()
+        {
+            RiveAPI.Scene_RegisterDelegates(Delegates);
+        }
+
         public readonly IntPtr NativePtr;
+        public readonly RenderBackend Backend;
 
-        public Scene()
+        public Scene() : this(RenderBackend.Managed) { }
+
+        public Scene(RenderBackend backend)
         {
-            NativePtr = RiveAPI.Scene_New(RiveAPI.CreateNativeRef(Factory.Instance));
+            Backend = backend;
+            NativePtr = backend == RenderBackend.Software
+                ? RiveAPI.Scene_NewSoftware()
+                : RiveAPI.Scene_New(RiveAPI.CreateNativeRef(Factory.Instance));
         }
         ~Scene()
         {
@@ -35,13 +104,24 @@ namespace RiveSharp
         private bool _isLoaded = false;
         public bool IsLoaded => _isLoaded;
 
+        // Memory and file streams are imported in place, without first being copied to a new array.
         public bool LoadFile(Stream stream)
         {
-            var data = new byte[stream.Length];
-            stream.Read(data, 0, data.Length);
-            return LoadFile(data);
+            using (var file = RiveFile.Load(stream, Backend))
+            {
+                return LoadFile(file);
+            }
+        }
+
+        public bool LoadFile(ReadOnlySpan<byte> data)
+        {
+            using (var file = RiveFile.Load(data, Backend))
+            {
+                return LoadFile(file);
+            }
         }
 
+        // Scenes loaded from identical data share a single natively imported file.
         public bool LoadFile(byte[] data)
         {
             _isLoaded = false;
@@ -52,6 +132,21 @@ namespace RiveSharp
             return RiveAPI.Scene_LoadFile(NativePtr, data, data.Length) != 0;
         }
 
+        // Shares an already-imported file. The native file stays alive for as long as this Scene
+        // references it, even if the RiveFile is disposed. Fails if the file was loaded for a
+        // different RenderBackend.
+        public bool LoadFile(RiveFile file)
+        {
+            _isLoaded = false;
+            if (file == null || file.NativePtr == IntPtr.Zero)
+            {
+                return false;
+            }
+            bool success = RiveAPI.Scene_LoadFromFile(NativePtr, file.NativePtr) != 0;
+            GC.KeepAlive(file);
+            return success;
+        }
+
         // Loads an artboard and animation from the already-loaded file.
         public bool LoadArtboard(string artboardName)
         {
@@ -97,6 +192,46 @@ namespace RiveSharp
             }
         }
 
+        // Resolves a state machine input name to a handle for the setters below, which avoid
+        // marshaling and searching for the name on every call. Handles remain valid until a different
+        // state machine or animation is loaded. Returns -1 if the input does not exist.
+        public int GetInputHandle(string name) => RiveAPI.Scene_InputHandle(NativePtr, name);
+
+        public void SetBool(int handle, bool value)
+        {
+            if (this.IsLoaded && RiveAPI.Scene_SetBoolAt(NativePtr, handle, value ? 1 : 0) == 0)
+            {
+                throw new Exception($"State machine bool input handle {handle} not found.");
+            }
+        }
+
+        public void SetNumber(int handle, float value)
+        {
+            if (this.IsLoaded && RiveAPI.Scene_SetNumberAt(NativePtr, handle, value) == 0)
+            {
+                throw new Exception($"State machine number input handle {handle} not found.");
+            }
+        }
+
+        public void FireTrigger(int handle)
+        {
+            if (this.IsLoaded && RiveAPI.Scene_FireTriggerAt(NativePtr, handle) == 0)
+            {
+                throw new Exception($"State machine trigger input handle {handle} not found.");
+            }
+        }
+
+        // Applies the first count values in a single call. Returns the number of values whose handle
+        // referred to an existing input.
+        public int SetInputs(StateMachineInputValue[] values, int count)
+        {
+            if (count < 0 || count > values.Length)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+            return this.IsLoaded ? RiveAPI.Scene_SetInputs(NativePtr, values, count) : 0;
+        }
+
         public float Width => RiveAPI.Scene_Width(NativePtr);
         public float Height => RiveAPI.Scene_Height(NativePtr);
 
@@ -130,15 +265,272 @@ namespace RiveSharp
             return RiveAPI.Scene_AdvanceAndApply(NativePtr, (float)elapsedSeconds) != 0;
         }
 
+        // Jumps a linear animation straight to the given time from its start (clamped to its
+        // duration) and applies it, at the same cost wherever the time falls. Returns false, without
+        // doing anything, if the loaded scene is a state machine.
+        public bool SeekTo(double seconds)
+        {
+            return RiveAPI.Scene_SeekTo(NativePtr, (float)seconds) != 0;
+        }
+
+        // Computes the region of the artboard, in artboard coordinates, whose pixels may have changed
+        // since the previous call, by comparing every draw's transform, geometry and paint with the
+        // previous call's. Returns false if nothing changed, in which case a host that retains its
+        // pixels can skip the frame. Otherwise it can clip its redraw to the bounds (mapped through
+        // its alignment transform, and outset by a pixel for antialiasing). Scenes that use the
+        // Software backend always report their full bounds.
+        public bool GetDirtyBounds(out AABB bounds)
+        {
+            return RiveAPI.Scene_GetDirtyBounds(NativePtr, out bounds) != 0;
+        }
+
+        // Captures the loaded artboard and animation or state machine, along with the animation's
+        // time and direction or the state machine's input values, in a compact opaque blob. Returns
+        // null if nothing is loaded.
+        public byte[] Snapshot()
+        {
+            int size = RiveAPI.Scene_Snapshot(NativePtr, null, 0);
+            if (size == 0)
+            {
+                return null;
+            }
+            var snapshot = new byte[size];
+            RiveAPI.Scene_Snapshot(NativePtr, snapshot, size);
+            return snapshot;
+        }
+
+        // Restores a snapshot taken from any Scene in this process that loaded the same file, and
+        // applies it so it's ready to draw. Restoring into the animation that's already loaded is
+        // cheap enough to scrub with.
+        //
+        // State machines are NOT resumed: the runtime doesn't expose their layers' states, so only
+        // the input values are captured. Restoring a state machine snapshot always gives a fresh
+        // instance at its entry states with those inputs, whatever this Scene was doing before.
+        //
+        // Returns false, leaving the Scene unchanged, if the snapshot can't be restored.
+        public bool Restore(byte[] snapshot)
+        {
+            if (snapshot == null)
+            {
+                return false;
+            }
+            if (RiveAPI.Scene_Restore(NativePtr, snapshot, snapshot.Length) == 0)
+            {
+                return false;
+            }
+            _isLoaded = true;
+            return true;
+        }
+
+        // Records the frame natively and replays it onto the renderer in a single interop call.
         public void Draw(Renderer renderer)
         {
-            var gch = GCHandle.Alloc(renderer);
-            RiveAPI.Scene_Draw(NativePtr, GCHandle.ToIntPtr(gch));
-            gch.Free();
+            var rendererRef = RiveAPI.CreateNativeRef(renderer);
+            RiveAPI.Scene_DrawBatched(NativePtr, rendererRef);
+            RiveAPI.ReleaseNativeRef(rendererRef);
+        }
+
+        // Draws the first count cells, each aligned into its frame, with a single interop call for
+        // the whole batch, which suits icon grids and virtualized lists. Cells whose frame lies
+        // entirely outside the viewport (in the renderer's current coordinates) are skipped.
+        // Returns the number of cells drawn.
+        public static int DrawAtlas(Renderer renderer, AtlasCell[] cells, int count, AABB viewport)
+        {
+            if (count < 0 || count > cells.Length)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+            if (t_atlasEntries == null || t_atlasEntries.Length < count)
+            {
+                t_atlasEntries = new RiveAPI.AtlasEntry[Math.Max(count, 64)];
+            }
+            var entries = t_atlasEntries;
+            for (int i = 0; i < count; ++i)
+            {
+                var cell = cells[i];
+                entries[i] = new RiveAPI.AtlasEntry
+                {
+                    Scene = cell.Scene != null ? cell.Scene.NativePtr : IntPtr.Zero,
+                    Frame = cell.Frame,
+                    Fit = (int)cell.Fit,
+                    AlignX = cell.Alignment.X,
+                    AlignY = cell.Alignment.Y
+                };
+            }
+            var rendererRef = RiveAPI.CreateNativeRef(renderer);
+            int drawn = RiveAPI.Scene_DrawAtlas(rendererRef, entries, count, viewport);
+            RiveAPI.ReleaseNativeRef(rendererRef);
+            GC.KeepAlive(cells);
+            return drawn;
+        }
+
+        // Reused between DrawAtlas calls.
+        [ThreadStatic] static RiveAPI.AtlasEntry[] t_atlasEntries;
+
+        // Draws by calling back into the renderer once for every individual render command.
+        public void DrawImmediate(Renderer renderer)
+        {
+            var rendererRef = RiveAPI.CreateNativeRef(renderer);
+            RiveAPI.Scene_Draw(NativePtr, rendererRef);
+            RiveAPI.ReleaseNativeRef(rendererRef);
+        }
+
+        // Interop counters and advance/draw timings for this Scene, collected natively.
+        public unsafe SceneStats GetStats()
+        {
+            SceneStats stats;
+            RiveAPI.Scene_GetStats(NativePtr, &stats);
+            return stats;
+        }
+
+        // Rasterizes a Software scene into premultiplied RGBA8888 pixels[height][rowBytes],
+        // compositing over the existing contents. Returns false if nothing is loaded.
+        public bool DrawToBuffer(IntPtr pixels, int width, int height, int rowBytes, Mat2D transform)
+        {
+            if (Backend != RenderBackend.Software)
+            {
+                throw new InvalidOperationException("Only Software scenes can draw to a buffer.");
+            }
+            return RiveAPI.Scene_DrawSoftware(NativePtr,
+                                              pixels,
+                                              width,
+                                              height,
+                                              rowBytes,
+                                              transform) != 0;
+        }
+
+        public unsafe bool DrawToBuffer(byte[] pixels, int width, int height, Mat2D transform)
+        {
+            if (pixels.Length < width * height * 4)
+            {
+                throw new ArgumentException("pixels must hold width * height RGBA values.");
+            }
+            fixed (byte* p = pixels)
+            {
+                return DrawToBuffer((IntPtr)p, width, height, width * 4, transform);
+            }
+        }
+
+        // Advances and draws frameCount frames of a Software scene in a single native call. The scene
+        // is first advanced by startSeconds, then by 1/fps before every frame after the first.
+        //
+        // Frame i is drawn into surfaces[i % surfaces.Length] (each width * height RGBA values) and
+        // then handed to onFrame. With more than one surface, later frames are rasterized on worker
+        // threads while onFrame runs. Returns the number of frames delivered (or rendered, if there
+        // is no handler).
+        public unsafe int RenderSequence(double startSeconds,
+                                         int frameCount,
+                                         double fps,
+                                         int width,
+                                         int height,
+                                         Mat2D transform,
+                                         byte[][] surfaces,
+                                         SequenceFrameHandler onFrame,
+                                         uint clearColor = 0)
+        {
+            if (Backend != RenderBackend.Software)
+            {
+                throw new InvalidOperationException("Only Software scenes can render sequences.");
+            }
+            if (surfaces == null || surfaces.Length == 0)
+            {
+                throw new ArgumentException("At least one surface is required.", nameof(surfaces));
+            }
+            var pins = new GCHandle[surfaces.Length];
+            var addresses = new IntPtr[surfaces.Length];
+            var sink = new SequenceSink { Surfaces = surfaces, Handler = onFrame };
+            var sinkRef = RiveAPI.CreateNativeRef(sink);
+            try
+            {
+                for (int i = 0; i < surfaces.Length; ++i)
+                {
+                    if (surfaces[i] == null || surfaces[i].Length < width * height * 4)
+                    {
+                        throw new ArgumentException("Each surface must hold width * height RGBA values.",
+                                                    nameof(surfaces));
+                    }
+                    pins[i] = GCHandle.Alloc(surfaces[i], GCHandleType.Pinned);
+                    addresses[i] = pins[i].AddrOfPinnedObject();
+                }
+                fixed (IntPtr* surfacePtrs = addresses)
+                {
+                    var args = new RiveAPI.RenderSequenceArgs
+                    {
+                        StartSeconds = (float)startSeconds,
+                        Fps = (float)fps,
+                        FrameCount = frameCount,
+                        Width = width,
+                        Height = height,
+                        RowBytes = width * 4,
+                        Transform = transform,
+                        ClearColor = clearColor,
+                        SurfaceCount = surfaces.Length,
+                        Surfaces = (IntPtr)surfacePtrs,
+                        FrameSink = onFrame != null ? sinkRef : IntPtr.Zero
+                    };
+                    int count = RiveAPI.Scene_RenderSequence(NativePtr, &args);
+                    if (sink.Exception != null)
+                    {
+                        throw new Exception("RenderSequence frame handler failed.", sink.Exception);
+                    }
+                    return count;
+                }
+            }
+            finally
+            {
+                foreach (var pin in pins)
+                {
+                    if (pin.IsAllocated)
+                    {
+                        pin.Free();
+                    }
+                }
+                RiveAPI.ReleaseNativeRef(sinkRef);
+            }
+        }
+
+        private class SequenceSink
+        {
+            public byte[][] Surfaces;
+            public SequenceFrameHandler Handler;
+            public Exception Exception;
+        }
+
+        // Exceptions can't unwind through the native frames (a worker may still be rendering into
+        // the surfaces), so they're stashed and rethrown once Scene_RenderSequence returns.
+        [MonoPInvokeCallback(typeof(SceneDelegates.FrameReadyDelegate))]
+        static Int32 FrameReadyCallback(IntPtr sinkRef, Int32 frame, Int32 surface)
+        {
+            var sink = RiveAPI.CastNativeRef<SequenceSink>(sinkRef);
+            try
+            {
+                return sink.Handler(frame, sink.Surfaces[surface]) ? 1 : 0;
+            }
+            catch (Exception e)
+            {
+                sink.Exception = e;
+                return 0;
+            }
         }
 
         public void PointerDown(Vec2D pos) => RiveAPI.Scene_PointerDown(NativePtr, pos);
         public void PointerMove(Vec2D pos) => RiveAPI.Scene_PointerMove(NativePtr, pos);
         public void PointerUp(Vec2D pos) => RiveAPI.Scene_PointerUp(NativePtr, pos);
+
+        // Sets the transform that QueuePointerEvent maps view positions into the artboard with (the
+        // inverse of the view's alignment). Applied when the events are dispatched, and kept until
+        // it's set again. May be called from any thread.
+        public void SetPointerTransform(Mat2D viewToArtboard)
+        {
+            RiveAPI.Scene_SetPointerTransform(NativePtr, viewToArtboard);
+        }
+
+        // Queues a pointer event in view coordinates, to be dispatched at the start of the next
+        // AdvanceAndApply. Consecutive moves coalesce, so high-rate input costs the state machine
+        // one move per frame. May be called from any thread.
+        public void QueuePointerEvent(PointerEventType type, Vec2D viewPosition)
+        {
+            RiveAPI.Scene_QueuePointerEvent(NativePtr, (int)type, viewPosition);
+        }
     }
 }
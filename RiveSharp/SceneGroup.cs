@@ -0,0 +1,106 @@
+// Copyright 2022 Rive
+
+using System;
+using System.Collections.Generic;
+
+namespace RiveSharp
+{
+    // A set of independent Scenes that are advanced together with a single interop call. The
+    // native side spreads the scenes across a pool of worker threads, so state machine and
+    // animation work scales with the number of cores.
+    //
+    // The scenes must not be used from any other thread while AdvanceAll() is running.
+    public class SceneGroup : IDisposable
+    {
+        private IntPtr _nativePtr;
+        public IntPtr NativePtr => _nativePtr;
+
+        // Keeps the scenes (and therefore their native counterparts) alive while they're grouped.
+        private readonly List<Scene> _scenes = new List<Scene>();
+        // Each scene may only be grouped once, or two workers would advance it at the same time.
+        private readonly HashSet<Scene> _members = new HashSet<Scene>();
+        private byte[] _needsRedraw = new byte[0];
+
+        public SceneGroup()
+        {
+            _nativePtr = RiveAPI.SceneGroup_New();
+        }
+        ~SceneGroup()
+        {
+            Release();
+        }
+
+        public int Count => _scenes.Count;
+        public Scene this[int index] => _scenes[index];
+
+        // Returns false if the scene is already in the group.
+        public bool Add(Scene scene)
+        {
+            ThrowIfDisposed();
+            if (!_members.Add(scene))
+            {
+                return false;
+            }
+            _scenes.Add(scene);
+            RiveAPI.SceneGroup_Add(_nativePtr, scene.NativePtr);
+            return true;
+        }
+
+        public bool Remove(Scene scene)
+        {
+            ThrowIfDisposed();
+            if (!_members.Remove(scene))
+            {
+                return false;
+            }
+            _scenes.Remove(scene);
+            RiveAPI.SceneGroup_Remove(_nativePtr, scene.NativePtr);
+            return true;
+        }
+
+        // Advances every scene in parallel. Returns the number of scenes that need to be drawn;
+        // NeedsRedraw() reports which ones.
+        public int AdvanceAll(double elapsedSeconds)
+        {
+            ThrowIfDisposed();
+            int nBytes = (_scenes.Count + 7) / 8;
+            if (_needsRedraw.Length < nBytes)
+            {
+                _needsRedraw = new byte[nBytes];
+            }
+            return RiveAPI.SceneGroup_AdvanceAll(_nativePtr, (float)elapsedSeconds, _needsRedraw);
+        }
+
+        // True if the scene at index needed to be drawn after the most recent AdvanceAll().
+        public bool NeedsRedraw(int index)
+        {
+            return (_needsRedraw[index / 8] & (1 << (index % 8))) != 0;
+        }
+
+        // Deletes the native group and lets go of the scenes. The scenes themselves stay usable.
+        public void Dispose()
+        {
+            Release();
+            _scenes.Clear();
+            _members.Clear();
+            GC.SuppressFinalize(this);
+        }
+
+        private void Release()
+        {
+            if (_nativePtr != IntPtr.Zero)
+            {
+                RiveAPI.SceneGroup_Delete(_nativePtr);
+                _nativePtr = IntPtr.Zero;
+            }
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (_nativePtr == IntPtr.Zero)
+            {
+                throw new ObjectDisposedException(nameof(SceneGroup));
+            }
+        }
+    }
+}
@@ -0,0 +1,741 @@
+// Headless driver for librive's exported C API, for CI and render farm machines
+// without a UI or .NET. Stands in for the managed side with delegates that
+// count their calls and track every managed ref native code is handed, then
+// loads each .riv file, advances and draws it for a number of frames, and
+// checks that:
+//
+//   * every path, paint and image the renderer draws with is still alive,
+//   * no ref is released twice, or released without having been created,
+//   * saves and restores balance,
+//   * the library's own reverse P/Invoke counters match the calls received,
+//   * deleting the scene releases every ref it was given, and its factory.
+//
+// Also reports advance and draw times per frame, for throughput tests:
+//
+//   interopharness [--frames 300] file.riv...
+//
+// With --software, each file is instead drawn by the native software backend,
+// and a checksum of the final frame's pixels is compared against the golden
+// checksums in a file (or recorded there, with --record). Checksums depend on
+// the compiler and instruction set, so keep one golden file per platform:
+//
+//   interopharness --software --golden linux-x64.txt [--record] file.riv...
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#ifdef _WIN32
+#define RIVE_CDECL __cdecl
+#else
+#define RIVE_CDECL
+#endif
+
+// Must match ManagedCallKind in RiveSharpInterop.cpp.
+enum class ManagedCallKind : int32_t
+{
+    renderPath,
+    renderImage,
+    renderPaint,
+    renderer,
+    factory,
+    scene,
+    count
+};
+
+// The delegate structs below must match the ones in RiveSharpInterop.cpp, the
+// same way the managed ones in RiveSharp do.
+struct InteropDelegates
+{
+    void(RIVE_CDECL* releaseRefs)(const intptr_t* refs, int32_t count);
+};
+
+struct RenderPathDelegates
+{
+    void(RIVE_CDECL* commit)(intptr_t ref,
+                             const float* pts,
+                             int nPts,
+                             const uint8_t* verbs,
+                             int nVerbs,
+                             int fillRule);
+};
+
+struct RenderImageDelegates
+{
+    int32_t(RIVE_CDECL* width)(intptr_t ref);
+    int32_t(RIVE_CDECL* height)(intptr_t ref);
+};
+
+struct RenderPaintDelegates
+{
+    void(RIVE_CDECL* style)(intptr_t ref, int style);
+    void(RIVE_CDECL* color)(intptr_t ref, uint32_t color);
+    void(RIVE_CDECL* linearGradient)(intptr_t ref,
+                                     uint32_t id,
+                                     float sx,
+                                     float sy,
+                                     float ex,
+                                     float ey,
+                                     const uint32_t colors[],
+                                     const float stops[],
+                                     int count);
+    void(RIVE_CDECL* radialGradient)(intptr_t ref,
+                                     uint32_t id,
+                                     float cx,
+                                     float cy,
+                                     float radius,
+                                     const uint32_t colors[],
+                                     const float stops[],
+                                     int count);
+    void(RIVE_CDECL* thickness)(intptr_t ref, float thickness);
+    void(RIVE_CDECL* join)(intptr_t ref, int join);
+    void(RIVE_CDECL* cap)(intptr_t ref, int cap);
+    void(RIVE_CDECL* blendMode)(intptr_t ref, int blendMode);
+};
+
+struct RenderBufferDelegates
+{
+    void(RIVE_CDECL* release)(uint32_t id);
+};
+
+struct RendererDelegates
+{
+    void(RIVE_CDECL* save)(intptr_t ref);
+    void(RIVE_CDECL* restore)(intptr_t ref);
+    void(RIVE_CDECL* transform)(intptr_t ref,
+                                float,
+                                float,
+                                float,
+                                float,
+                                float,
+                                float);
+    void(RIVE_CDECL* drawPath)(intptr_t ref, intptr_t path, intptr_t paint);
+    void(RIVE_CDECL* clipPath)(intptr_t ref, intptr_t path);
+    void(RIVE_CDECL* drawImage)(intptr_t ref,
+                                intptr_t image,
+                                int blendMode,
+                                float opacity);
+    void(RIVE_CDECL* drawImageMesh)(intptr_t ref,
+                                    intptr_t image,
+                                    const float* vertices,
+                                    const float* texcoords,
+                                    uint32_t texcoordsID,
+                                    uint32_t texcoordsVersion,
+                                    int vertexCount,
+                                    const uint16_t* indices,
+                                    uint32_t indicesID,
+                                    uint32_t indicesVersion,
+                                    int indexCount,
+                                    int blendMode,
+                                    float opacity);
+    void(RIVE_CDECL* drawCommands)(intptr_t ref,
+                                   const uint8_t* commands,
+                                   int32_t nBytes);
+};
+
+struct FactoryDelegates
+{
+    void(RIVE_CDECL* release)(intptr_t ref);
+    intptr_t(RIVE_CDECL* makeRenderPath)(intptr_t ref,
+                                         intptr_t ptsArray,
+                                         int nPts,
+                                         intptr_t verbsArray,
+                                         int nVerbs,
+                                         int fillRule);
+    intptr_t(RIVE_CDECL* makeEmptyRenderPath)(intptr_t ref);
+    intptr_t(RIVE_CDECL* makeRenderPaint)(intptr_t ref);
+    intptr_t(RIVE_CDECL* decodeImage)(intptr_t ref,
+                                      intptr_t bytesArray,
+                                      int nBytes);
+};
+
+struct SceneDelegates
+{
+    int32_t(RIVE_CDECL* frameReady)(intptr_t sink,
+                                    int32_t frame,
+                                    int32_t surface);
+};
+
+// Must match rive::Mat2D.
+struct Mat2D
+{
+    float xx, xy, yx, yy, tx, ty;
+};
+
+extern "C"
+{
+    void RIVE_CDECL Interop_RegisterDelegates(InteropDelegates);
+    void RIVE_CDECL RenderPath_RegisterDelegates(RenderPathDelegates);
+    void RIVE_CDECL RenderImage_RegisterDelegates(RenderImageDelegates);
+    void RIVE_CDECL RenderPaint_RegisterDelegates(RenderPaintDelegates);
+    void RIVE_CDECL RenderBuffer_RegisterDelegates(RenderBufferDelegates);
+    void RIVE_CDECL Renderer_RegisterDelegates(RendererDelegates);
+    void RIVE_CDECL Factory_RegisterDelegates(FactoryDelegates);
+    void RIVE_CDECL Scene_RegisterDelegates(SceneDelegates);
+
+    int32_t RIVE_CDECL Interop_GetCallCounts(int64_t* counts, int32_t max);
+    void RIVE_CDECL Interop_ResetCallCounts();
+    void RIVE_CDECL Interop_FlushReleases();
+
+    intptr_t RIVE_CDECL Scene_New(intptr_t managedFactory);
+    intptr_t RIVE_CDECL Scene_NewSoftware();
+    void RIVE_CDECL Scene_Delete(intptr_t ref);
+    int8_t RIVE_CDECL Scene_LoadFile(intptr_t ref,
+                                     const uint8_t* fileBytes,
+                                     int length);
+    int8_t RIVE_CDECL Scene_LoadArtboard(intptr_t ref, const char* name);
+    int8_t RIVE_CDECL Scene_LoadStateMachine(intptr_t ref, const char* name);
+    int8_t RIVE_CDECL Scene_LoadAnimation(intptr_t ref, const char* name);
+    int8_t RIVE_CDECL Scene_AdvanceAndApply(intptr_t ref, float elapsed);
+    void RIVE_CDECL Scene_Draw(intptr_t ref, intptr_t renderer);
+    int8_t RIVE_CDECL Scene_DrawSoftware(intptr_t ref,
+                                         uint8_t* pixels,
+                                         int32_t width,
+                                         int32_t height,
+                                         int32_t rowBytes,
+                                         Mat2D transform);
+    float RIVE_CDECL Scene_Width(intptr_t ref);
+    float RIVE_CDECL Scene_Height(intptr_t ref);
+}
+
+// The refs of the one factory and renderer. Everything else gets a fresh ref
+// above these.
+static constexpr intptr_t kFactoryRef = 1;
+static constexpr intptr_t kRendererRef = 2;
+
+static std::atomic<int64_t> s_calls[(size_t)ManagedCallKind::count];
+static std::atomic<int64_t> s_saves, s_restores, s_drawPaths, s_drawImages;
+static std::atomic<int64_t> s_factoryReleases;
+// Refs that were used after being released, or released when not alive.
+static std::atomic<int64_t> s_deadRefUses, s_badReleases;
+
+static std::mutex s_refsMutex;
+static std::unordered_set<intptr_t> s_liveRefs;
+static intptr_t s_lastRef = kRendererRef;
+
+static void Count(ManagedCallKind kind)
+{
+    s_calls[(size_t)kind].fetch_add(1, std::memory_order_relaxed);
+}
+
+static intptr_t NewRef()
+{
+    std::lock_guard<std::mutex> lock(s_refsMutex);
+    s_liveRefs.insert(++s_lastRef);
+    return s_lastRef;
+}
+
+static void CheckLive(intptr_t ref)
+{
+    std::lock_guard<std::mutex> lock(s_refsMutex);
+    if (s_liveRefs.count(ref) == 0)
+    {
+        ++s_deadRefUses;
+    }
+}
+
+static size_t LiveRefCount()
+{
+    std::lock_guard<std::mutex> lock(s_refsMutex);
+    return s_liveRefs.size();
+}
+
+static void RIVE_CDECL ReleaseRefs(const intptr_t* refs, int32_t count)
+{
+    Count(ManagedCallKind::factory);
+    std::lock_guard<std::mutex> lock(s_refsMutex);
+    for (int32_t i = 0; i < count; ++i)
+    {
+        if (s_liveRefs.erase(refs[i]) == 0)
+        {
+            ++s_badReleases;
+        }
+    }
+}
+
+static void RIVE_CDECL
+CommitPath(intptr_t ref, const float*, int, const uint8_t*, int, int)
+{
+    Count(ManagedCallKind::renderPath);
+    CheckLive(ref);
+}
+
+static int32_t RIVE_CDECL ImageSize(intptr_t ref)
+{
+    Count(ManagedCallKind::renderImage);
+    CheckLive(ref);
+    return 64;
+}
+
+template <typename... Args>
+static void RIVE_CDECL PaintCall(intptr_t ref, Args...)
+{
+    Count(ManagedCallKind::renderPaint);
+    CheckLive(ref);
+}
+
+static void RIVE_CDECL ReleaseBuffer(uint32_t)
+{
+    Count(ManagedCallKind::factory);
+}
+
+static void RIVE_CDECL Save(intptr_t)
+{
+    Count(ManagedCallKind::renderer);
+    ++s_saves;
+}
+
+static void RIVE_CDECL Restore(intptr_t)
+{
+    Count(ManagedCallKind::renderer);
+    ++s_restores;
+}
+
+static void RIVE_CDECL
+Transform(intptr_t, float, float, float, float, float, float)
+{
+    Count(ManagedCallKind::renderer);
+}
+
+static void RIVE_CDECL DrawPath(intptr_t, intptr_t path, intptr_t paint)
+{
+    Count(ManagedCallKind::renderer);
+    ++s_drawPaths;
+    CheckLive(path);
+    CheckLive(paint);
+}
+
+static void RIVE_CDECL ClipPath(intptr_t, intptr_t path)
+{
+    Count(ManagedCallKind::renderer);
+    CheckLive(path);
+}
+
+static void RIVE_CDECL DrawImage(intptr_t, intptr_t image, int, float)
+{
+    Count(ManagedCallKind::renderer);
+    ++s_drawImages;
+    CheckLive(image);
+}
+
+static void RIVE_CDECL DrawImageMesh(intptr_t,
+                                     intptr_t image,
+                                     const float*,
+                                     const float*,
+                                     uint32_t,
+                                     uint32_t,
+                                     int,
+                                     const uint16_t*,
+                                     uint32_t,
+                                     uint32_t,
+                                     int,
+                                     int,
+                                     float)
+{
+    Count(ManagedCallKind::renderer);
+    ++s_drawImages;
+    CheckLive(image);
+}
+
+static void RIVE_CDECL DrawCommands(intptr_t, const uint8_t*, int32_t)
+{
+    Count(ManagedCallKind::renderer);
+}
+
+static void RIVE_CDECL ReleaseFactory(intptr_t)
+{
+    Count(ManagedCallKind::factory);
+    ++s_factoryReleases;
+}
+
+static intptr_t RIVE_CDECL
+MakeRenderPath(intptr_t, intptr_t, int, intptr_t, int, int)
+{
+    Count(ManagedCallKind::factory);
+    return NewRef();
+}
+
+static intptr_t RIVE_CDECL MakeRef(intptr_t)
+{
+    Count(ManagedCallKind::factory);
+    return NewRef();
+}
+
+static intptr_t RIVE_CDECL DecodeImage(intptr_t, intptr_t, int)
+{
+    Count(ManagedCallKind::factory);
+    return NewRef();
+}
+
+static int32_t RIVE_CDECL FrameReady(intptr_t, int32_t, int32_t)
+{
+    Count(ManagedCallKind::scene);
+    return 0;
+}
+
+static void RegisterDelegates()
+{
+    Interop_RegisterDelegates({ReleaseRefs});
+    RenderPath_RegisterDelegates({CommitPath});
+    RenderImage_RegisterDelegates({ImageSize, ImageSize});
+    RenderPaint_RegisterDelegates({PaintCall<int>,
+                                   PaintCall<uint32_t>,
+                                   PaintCall<uint32_t,
+                                             float,
+                                             float,
+                                             float,
+                                             float,
+                                             const uint32_t*,
+                                             const float*,
+                                             int>,
+                                   PaintCall<uint32_t,
+                                             float,
+                                             float,
+                                             float,
+                                             const uint32_t*,
+                                             const float*,
+                                             int>,
+                                   PaintCall<float>,
+                                   PaintCall<int>,
+                                   PaintCall<int>,
+                                   PaintCall<int>});
+    RenderBuffer_RegisterDelegates({ReleaseBuffer});
+    Renderer_RegisterDelegates({Save,
+                                Restore,
+                                Transform,
+                                DrawPath,
+                                ClipPath,
+                                DrawImage,
+                                DrawImageMesh,
+                                DrawCommands});
+    Factory_RegisterDelegates(
+        {ReleaseFactory, MakeRenderPath, MakeRef, MakeRef, DecodeImage});
+    Scene_RegisterDelegates({FrameReady});
+}
+
+static void ResetCounts()
+{
+    Interop_ResetCallCounts();
+    for (auto& counter : s_calls)
+    {
+        counter = 0;
+    }
+    s_saves = s_restores = s_drawPaths = s_drawImages = 0;
+    s_factoryReleases = s_deadRefUses = s_badReleases = 0;
+}
+
+static bool ReadFile(const char* path, std::vector<uint8_t>* bytes)
+{
+    std::ifstream stream(path, std::ios::binary);
+    bytes->assign(std::istreambuf_iterator<char>(stream),
+                  std::istreambuf_iterator<char>());
+    if (!stream && !stream.eof())
+    {
+        printf("FAIL %s: can't read file\n", path);
+        return false;
+    }
+    return true;
+}
+
+static bool LoadDefaultScene(intptr_t scene, const std::vector<uint8_t>& bytes)
+{
+    return Scene_LoadFile(scene, bytes.data(), (int)bytes.size()) &&
+           Scene_LoadArtboard(scene, "") &&
+           (Scene_LoadStateMachine(scene, "") ||
+            Scene_LoadAnimation(scene, ""));
+}
+
+// Advances and draws one file for the given number of frames. Returns false if
+// any check failed.
+static bool RunFile(const char* path, int frames)
+{
+    std::vector<uint8_t> bytes;
+    if (!ReadFile(path, &bytes))
+    {
+        return false;
+    }
+
+    ResetCounts();
+    bool passed = true;
+    auto check = [&](bool condition, const char* what) {
+        if (!condition)
+        {
+            printf("FAIL %s: %s\n", path, what);
+            passed = false;
+        }
+    };
+
+    intptr_t scene = Scene_New(kFactoryRef);
+    if (!LoadDefaultScene(scene, bytes))
+    {
+        check(false, "can't load the default artboard and scene");
+        Scene_Delete(scene);
+        return false;
+    }
+
+    std::chrono::duration<double, std::micro> advanceTime(0), drawTime(0);
+    for (int i = 0; i < frames; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Scene_AdvanceAndApply(scene, 1 / 60.f);
+        auto advanced = std::chrono::steady_clock::now();
+        Scene_Draw(scene, kRendererRef);
+        auto drawn = std::chrono::steady_clock::now();
+        advanceTime += advanced - start;
+        drawTime += drawn - advanced;
+    }
+    check(s_saves.load() == s_restores.load(),
+          "saves and restores don't balance");
+    int64_t drawPaths = s_drawPaths, drawImages = s_drawImages;
+    int64_t rendererCalls = s_calls[(size_t)ManagedCallKind::renderer];
+
+    Scene_Delete(scene);
+    Interop_FlushReleases();
+    check(s_deadRefUses == 0, "used a released or unknown ref");
+    check(s_badReleases == 0, "released a ref twice, or an unknown ref");
+    check(LiveRefCount() == 0, "leaked refs after Scene_Delete");
+    check(s_factoryReleases == 1, "didn't release the factory exactly once");
+
+    int64_t nativeCounts[(size_t)ManagedCallKind::count];
+    int32_t n = Interop_GetCallCounts(nativeCounts,
+                                      (int32_t)ManagedCallKind::count);
+    check(n == (int32_t)ManagedCallKind::count, "unexpected call kind count");
+    for (int32_t i = 0; i < std::min(n, (int32_t)ManagedCallKind::count); ++i)
+    {
+        check(nativeCounts[i] == s_calls[i],
+              "native call counters don't match the calls received");
+    }
+
+    printf("%s %s  advance %8.1f us  draw %8.1f us  (%lld paths, "
+           "%lld images, %lld renderer calls per frame)\n",
+           passed ? "PASS" : "FAIL",
+           path,
+           advanceTime.count() / frames,
+           drawTime.count() / frames,
+           (long long)(drawPaths / frames),
+           (long long)(drawImages / frames),
+           (long long)(rendererCalls / frames));
+    return passed;
+}
+
+// 64-bit FNV-1a.
+static uint64_t HashBytes(const uint8_t* bytes, size_t length)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// Golden checksums of the software backend's output, by file name.
+using Goldens = std::map<std::string, uint64_t>;
+
+static std::string BaseName(const char* path)
+{
+    const char* name = path;
+    for (const char* c = path; *c; ++c)
+    {
+        if (*c == '/' || *c == '\\')
+        {
+            name = c + 1;
+        }
+    }
+    return name;
+}
+
+static bool ReadGoldens(const char* path, Goldens* goldens)
+{
+    std::ifstream stream(path);
+    std::string name;
+    std::string checksum;
+    while (stream >> checksum >> name)
+    {
+        (*goldens)[name] = strtoull(checksum.c_str(), nullptr, 16);
+    }
+    return !stream.bad();
+}
+
+static bool WriteGoldens(const char* path, const Goldens& goldens)
+{
+    FILE* file = fopen(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+    for (const auto& golden : goldens)
+    {
+        fprintf(file,
+                "%016llx %s\n",
+                (unsigned long long)golden.second,
+                golden.first.c_str());
+    }
+    return fclose(file) == 0;
+}
+
+// Advances and draws one file with the software backend, at kSoftwareSize
+// pixels fit to the artboard, and checks (or records) the checksum of the
+// final frame. Returns false if any check failed.
+static bool RunSoftwareFile(const char* path,
+                            int frames,
+                            Goldens* goldens,
+                            bool record)
+{
+    constexpr int32_t kSoftwareSize = 256;
+    std::vector<uint8_t> bytes;
+    if (!ReadFile(path, &bytes))
+    {
+        return false;
+    }
+    intptr_t scene = Scene_NewSoftware();
+    if (!LoadDefaultScene(scene, bytes))
+    {
+        Scene_Delete(scene);
+        // The software backend refuses files with images, since it can't
+        // draw them. Those are skipped, provided they load otherwise.
+        intptr_t managedScene = Scene_New(kFactoryRef);
+        bool loads = LoadDefaultScene(managedScene, bytes);
+        Scene_Delete(managedScene);
+        if (loads)
+        {
+            printf("SKIP %s: has images, which the software backend can't "
+                   "draw\n",
+                   path);
+            return true;
+        }
+        printf("FAIL %s: can't load the default artboard and scene\n", path);
+        return false;
+    }
+
+    float width = Scene_Width(scene), height = Scene_Height(scene);
+    float scale = width > 0 && height > 0
+                      ? std::min(kSoftwareSize / width, kSoftwareSize / height)
+                      : 1;
+    Mat2D fit = {scale, 0, 0, scale, 0, 0};
+    std::vector<uint8_t> pixels((size_t)kSoftwareSize * kSoftwareSize * 4);
+    std::chrono::duration<double, std::micro> advanceTime(0), drawTime(0);
+    bool drawn = true;
+    for (int i = 0; i < frames; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Scene_AdvanceAndApply(scene, 1 / 60.f);
+        auto advanced = std::chrono::steady_clock::now();
+        std::fill(pixels.begin(), pixels.end(), 0);
+        drawn = Scene_DrawSoftware(scene,
+                                   pixels.data(),
+                                   kSoftwareSize,
+                                   kSoftwareSize,
+                                   kSoftwareSize * 4,
+                                   fit) &&
+                drawn;
+        advanceTime += advanced - start;
+        drawTime += std::chrono::steady_clock::now() - advanced;
+    }
+    Scene_Delete(scene);
+
+    uint64_t checksum = HashBytes(pixels.data(), pixels.size());
+    std::string name = BaseName(path);
+    auto golden = goldens->find(name);
+    const char* result = "PASS";
+    if (!drawn)
+    {
+        result = "FAIL (not drawn)";
+    }
+    else if (record)
+    {
+        (*goldens)[name] = checksum;
+        result = "RECORDED";
+    }
+    else if (golden == goldens->end())
+    {
+        result = "FAIL (no golden)";
+    }
+    else if (golden->second != checksum)
+    {
+        result = "FAIL (checksum differs from golden)";
+    }
+    printf("%s %s  advance %8.1f us  draw %8.1f us  checksum %016llx\n",
+           result,
+           path,
+           advanceTime.count() / frames,
+           drawTime.count() / frames,
+           (unsigned long long)checksum);
+    return strncmp(result, "FAIL", 4) != 0;
+}
+
+int main(int argc, const char** argv)
+{
+    int frames = 300;
+    bool software = false, record = false;
+    const char* goldenPath = nullptr;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            frames = std::max(atoi(argv[++i]), 1);
+        }
+        else if (strcmp(argv[i], "--software") == 0)
+        {
+            software = true;
+        }
+        else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+        {
+            goldenPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--record") == 0)
+        {
+            record = true;
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty() || (software && !goldenPath))
+    {
+        printf("usage: interopharness [--frames 300] file.riv...\n"
+               "       interopharness --software --golden goldens.txt "
+               "[--record] [--frames 300] file.riv...\n");
+        return 2;
+    }
+
+    Goldens goldens;
+    if (software && !ReadGoldens(goldenPath, &goldens))
+    {
+        printf("can't read %s\n", goldenPath);
+        return 2;
+    }
+    RegisterDelegates();
+    int failures = 0;
+    for (const char* file : files)
+    {
+        bool passed = software ? RunSoftwareFile(file, frames, &goldens, record)
+                               : RunFile(file, frames);
+        if (!passed)
+        {
+            ++failures;
+        }
+    }
+    if (software && record && !WriteGoldens(goldenPath, goldens))
+    {
+        printf("can't write %s\n", goldenPath);
+        return 2;
+    }
+    printf("%d of %zu files passed\n",
+           (int)files.size() - failures,
+           files.size());
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+// Microbenchmark for MathKernels. Checks that the SIMD kernels agree with the
+// scalar ones, then times both on point arrays of a few sizes typical of paths
+// and skinned meshes:
+//
+//   kernelbench [iterations]
+
+#include "MathKernels.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace rive;
+
+template <typename Fn> static double NanosecondsPerCall(int iterations, Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        fn();
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// Keeps the optimizer from discarding results.
+static volatile float s_sink;
+
+int main(int argc, const char** argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+    printf("kernels: %s\n", kernels::SimdName());
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> coord(-1000, 1000);
+    const Mat2D m(.8f, .6f, -.6f, .8f, 12.5f, -3.25f);
+    bool mismatch = false;
+    for (size_t count : {15, 256, 4097})
+    {
+        std::vector<Vec2D> src(count), simd(count), scalar(count);
+        for (Vec2D& p : src)
+        {
+            p = Vec2D(coord(random), coord(random));
+        }
+
+        kernels::TransformPoints(m, src.data(), simd.data(), count);
+        kernels::scalar::TransformPoints(m, src.data(), scalar.data(), count);
+        AABB simdBounds = kernels::PointBounds(src.data(), count);
+        AABB scalarBounds = kernels::scalar::PointBounds(src.data(), count);
+        if (memcmp(simd.data(), scalar.data(), count * sizeof(Vec2D)) != 0 ||
+            memcmp(&simdBounds, &scalarBounds, sizeof(AABB)) != 0)
+        {
+            printf("MISMATCH between SIMD and scalar kernels at count %zu\n",
+                   count);
+            mismatch = true;
+        }
+
+        double transformSimd = NanosecondsPerCall(iterations, [&]() {
+            kernels::TransformPoints(m, src.data(), simd.data(), count);
+            s_sink = simd[count - 1].x;
+        });
+        double transformScalar = NanosecondsPerCall(iterations, [&]() {
+            kernels::scalar::TransformPoints(m,
+                                             src.data(),
+                                             scalar.data(),
+                                             count);
+            s_sink = scalar[count - 1].x;
+        });
+        double boundsSimd = NanosecondsPerCall(iterations, [&]() {
+            s_sink = kernels::PointBounds(src.data(), count).maxX;
+        });
+        double boundsScalar = NanosecondsPerCall(iterations, [&]() {
+            s_sink = kernels::scalar::PointBounds(src.data(), count).maxX;
+        });
+        printf("%5zu points  transform %9.1f ns (scalar %9.1f)"
+               "  bounds %9.1f ns (scalar %9.1f)\n",
+               count,
+               transformSimd,
+               transformScalar,
+               boundsSimd,
+               boundsScalar);
+    }
+    return mismatch ? 1 : 0;
+}
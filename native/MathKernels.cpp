@@ -0,0 +1,208 @@
+#include "MathKernels.hpp"
+#include <algorithm>
+
+#if defined(RIVE_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(RIVE_SIMD_NEON)
+#include <arm_neon.h>
+#elif defined(RIVE_SIMD_WASM)
+#include <wasm_simd128.h>
+#endif
+
+using namespace rive;
+
+namespace kernels
+{
+namespace scalar
+{
+void TransformPoints(const Mat2D& m,
+                     const Vec2D* src,
+                     Vec2D* dst,
+                     size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Separate statements, so -ffp-contract=on can't fuse these into FMAs
+        // (on ARM64) that the SIMD versions don't do.
+        Vec2D p = src[i];
+        float xx = m[0] * p.x, xy = m[1] * p.x;
+        float yx = m[2] * p.y, yy = m[3] * p.y;
+        float x = xx + yx, y = xy + yy;
+        dst[i] = Vec2D(x + m[4], y + m[5]);
+    }
+}
+
+AABB PointBounds(const Vec2D* points, size_t count)
+{
+    AABB bounds(points[0].x, points[0].y, points[0].x, points[0].y);
+    for (size_t i = 1; i < count; ++i)
+    {
+        const Vec2D& p = points[i];
+        bounds.minX = std::min(bounds.minX, p.x);
+        bounds.minY = std::min(bounds.minY, p.y);
+        bounds.maxX = std::max(bounds.maxX, p.x);
+        bounds.maxY = std::max(bounds.maxY, p.y);
+    }
+    return bounds;
+}
+} // namespace scalar
+
+// Each backend defines F32x4 and these operations on it. Points are loaded two
+// at a time, as [x0, y0, x1, y1].
+//
+//   Load2(p), Store2(p, v): two consecutive points.
+//   Splat4(a, b): [a, b, a, b].
+//   DupX(v), DupY(v): [x0, x0, x1, x1] and [y0, y0, y1, y1].
+//   Min(a, b), Max(a, b): per lane, b unless a < b (or a > b), like std::min
+//                         and std::max with a as the new value.
+#if defined(RIVE_SIMD_SSE2)
+using F32x4 = __m128;
+static F32x4 Load2(const Vec2D* p)
+{
+    return _mm_loadu_ps(reinterpret_cast<const float*>(p));
+}
+static void Store2(Vec2D* p, F32x4 v)
+{
+    _mm_storeu_ps(reinterpret_cast<float*>(p), v);
+}
+static F32x4 Splat4(float a, float b) { return _mm_setr_ps(a, b, a, b); }
+static F32x4 DupX(F32x4 v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+}
+static F32x4 DupY(F32x4 v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+}
+static F32x4 Mul(F32x4 a, F32x4 b) { return _mm_mul_ps(a, b); }
+static F32x4 Add(F32x4 a, F32x4 b) { return _mm_add_ps(a, b); }
+// minps returns its second operand unless the first is smaller.
+static F32x4 Min(F32x4 a, F32x4 b) { return _mm_min_ps(a, b); }
+static F32x4 Max(F32x4 a, F32x4 b) { return _mm_max_ps(a, b); }
+static void StoreLanes(F32x4 v, float out[4]) { _mm_storeu_ps(out, v); }
+#elif defined(RIVE_SIMD_NEON)
+using F32x4 = float32x4_t;
+static F32x4 Load2(const Vec2D* p)
+{
+    return vld1q_f32(reinterpret_cast<const float*>(p));
+}
+static void Store2(Vec2D* p, F32x4 v)
+{
+    vst1q_f32(reinterpret_cast<float*>(p), v);
+}
+static F32x4 Splat4(float a, float b)
+{
+    float32x2_t ab = vset_lane_f32(b, vdup_n_f32(a), 1);
+    return vcombine_f32(ab, ab);
+}
+static F32x4 DupX(F32x4 v) { return vtrn1q_f32(v, v); }
+static F32x4 DupY(F32x4 v) { return vtrn2q_f32(v, v); }
+static F32x4 Mul(F32x4 a, F32x4 b) { return vmulq_f32(a, b); }
+static F32x4 Add(F32x4 a, F32x4 b) { return vaddq_f32(a, b); }
+// vminq/vmaxq propagate NaNs, so select explicitly to match std::min/max.
+static F32x4 Min(F32x4 a, F32x4 b)
+{
+    return vbslq_f32(vcltq_f32(a, b), a, b);
+}
+static F32x4 Max(F32x4 a, F32x4 b)
+{
+    return vbslq_f32(vcgtq_f32(a, b), a, b);
+}
+static void StoreLanes(F32x4 v, float out[4]) { vst1q_f32(out, v); }
+#elif defined(RIVE_SIMD_WASM)
+using F32x4 = v128_t;
+static F32x4 Load2(const Vec2D* p) { return wasm_v128_load(p); }
+static void Store2(Vec2D* p, F32x4 v) { wasm_v128_store(p, v); }
+static F32x4 Splat4(float a, float b) { return wasm_f32x4_make(a, b, a, b); }
+static F32x4 DupX(F32x4 v) { return wasm_i32x4_shuffle(v, v, 0, 0, 2, 2); }
+static F32x4 DupY(F32x4 v) { return wasm_i32x4_shuffle(v, v, 1, 1, 3, 3); }
+static F32x4 Mul(F32x4 a, F32x4 b) { return wasm_f32x4_mul(a, b); }
+static F32x4 Add(F32x4 a, F32x4 b) { return wasm_f32x4_add(a, b); }
+// The "pseudo" min/max are defined as b < a ? b : a and a < b ? b : a.
+static F32x4 Min(F32x4 a, F32x4 b) { return wasm_f32x4_pmin(b, a); }
+static F32x4 Max(F32x4 a, F32x4 b) { return wasm_f32x4_pmax(b, a); }
+static void StoreLanes(F32x4 v, float out[4]) { wasm_v128_store(out, v); }
+#endif
+
+#if defined(RIVE_SIMD_SSE2) || defined(RIVE_SIMD_NEON) ||                     \
+    defined(RIVE_SIMD_WASM)
+void TransformPoints(const Mat2D& m,
+                     const Vec2D* src,
+                     Vec2D* dst,
+                     size_t count)
+{
+    F32x4 col0 = Splat4(m[0], m[1]);
+    F32x4 col1 = Splat4(m[2], m[3]);
+    F32x4 translate = Splat4(m[4], m[5]);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        F32x4 p = Load2(src + i);
+        Store2(dst + i,
+               Add(Add(Mul(col0, DupX(p)), Mul(col1, DupY(p))), translate));
+    }
+    scalar::TransformPoints(m, src + i, dst + i, count - i);
+}
+
+AABB PointBounds(const Vec2D* points, size_t count)
+{
+    if (count < 4)
+    {
+        return scalar::PointBounds(points, count);
+    }
+    // Two running [minX, minY, minX, minY] and [maxX, maxY, maxX, maxY],
+    // merged at the end.
+    F32x4 first = Load2(points);
+    F32x4 lo = first, hi = first;
+    size_t i = 2;
+    for (; i + 2 <= count; i += 2)
+    {
+        F32x4 p = Load2(points + i);
+        lo = Min(p, lo);
+        hi = Max(p, hi);
+    }
+    float l[4], h[4];
+    StoreLanes(lo, l);
+    StoreLanes(hi, h);
+    AABB bounds(std::min(l[0], l[2]),
+                std::min(l[1], l[3]),
+                std::max(h[0], h[2]),
+                std::max(h[1], h[3]));
+    if (i < count)
+    {
+        const Vec2D& p = points[i];
+        bounds.minX = std::min(bounds.minX, p.x);
+        bounds.minY = std::min(bounds.minY, p.y);
+        bounds.maxX = std::max(bounds.maxX, p.x);
+        bounds.maxY = std::max(bounds.maxY, p.y);
+    }
+    return bounds;
+}
+#else
+void TransformPoints(const Mat2D& m,
+                     const Vec2D* src,
+                     Vec2D* dst,
+                     size_t count)
+{
+    scalar::TransformPoints(m, src, dst, count);
+}
+
+AABB PointBounds(const Vec2D* points, size_t count)
+{
+    return scalar::PointBounds(points, count);
+}
+#endif
+
+const char* SimdName()
+{
+#if defined(RIVE_SIMD_SSE2)
+    return "sse2";
+#elif defined(RIVE_SIMD_NEON)
+    return "neon";
+#elif defined(RIVE_SIMD_WASM)
+    return "wasm-simd128";
+#else
+    return "scalar";
+#endif
+}
+} // namespace kernels
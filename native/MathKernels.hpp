@@ -0,0 +1,37 @@
+#pragma once
+
+#include "rive/math/aabb.hpp"
+#include "rive/math/mat2d.hpp"
+#include <cstddef>
+
+// Batch math over arrays of points. Every kernel has a portable scalar version,
+// and a SIMD version for whichever instruction set the build selects in
+// premake5.lua or premake5_wasm.lua (RIVE_SIMD_SSE2, RIVE_SIMD_NEON or
+// RIVE_SIMD_WASM). The SIMD versions process two points per 128-bit vector and
+// do the same float operations on each point as the scalar ones, so transforms
+// match exactly. Bounds can only differ in the sign of a zero, or with NaNs.
+namespace kernels
+{
+// Maps count points through m. dst may be the same array as src.
+void TransformPoints(const rive::Mat2D& m,
+                     const rive::Vec2D* src,
+                     rive::Vec2D* dst,
+                     size_t count);
+
+// Returns the bounds of count > 0 points.
+rive::AABB PointBounds(const rive::Vec2D* points, size_t count);
+
+// Name of the instruction set the kernels above were built for.
+const char* SimdName();
+
+// The portable versions, for builds without SIMD and for comparison.
+namespace scalar
+{
+void TransformPoints(const rive::Mat2D& m,
+                     const rive::Vec2D* src,
+                     rive::Vec2D* dst,
+                     size_t count);
+
+rive::AABB PointBounds(const rive::Vec2D* points, size_t count);
+} // namespace scalar
+} // namespace kernels
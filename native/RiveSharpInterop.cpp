@@ -8,6 +8,25 @@
 #include "rive/animation/state_machine_instance.hpp"
 #include "rive/artboard.hpp"
 #include "rive/renderer.hpp"
+#include "MathKernels.hpp"
+#include "SoftwareRenderer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
 
 using namespace rive;
 
@@ -34,13 +53,20 @@ static void msgbox(const char* format, ...) {
 }
 #endif
 
-#ifndef WASM
-#define RIVE_DLL(RET) extern "C" __declspec(dllexport) RET __cdecl
+// RIVE_EXPORT marks the library's exports. On Linux everything else is built
+// with -fvisibility=hidden, so these are the only symbols librive.so exposes.
+// __cdecl only exists on Windows; other platforms have one C calling
+// convention.
+#ifdef _WIN32
+#define RIVE_EXPORT __declspec(dllexport)
+#define RIVE_CDECL __cdecl
 #else
-#define RIVE_DLL(RET)                                                          \
-    extern "C" __attribute__((visibility("default"))) RET __cdecl
+#define RIVE_EXPORT __attribute__((visibility("default")))
+#define RIVE_CDECL
 #endif
 
+#define RIVE_DLL(RET) extern "C" RIVE_EXPORT RET RIVE_CDECL
+
 // Native P/Invoke functions may only return "blittable" types. To protect from
 // inadvertently returning an invalid type, we explicitly enumerate valid return
 // types here. See:
@@ -53,9 +79,288 @@ static void msgbox(const char* format, ...) {
 
 // Reverse P/Invoke Function pointers back into managed code are also __cdecl
 // and may also only return blittable types.
-#define RIVE_DELEGATE_VOID(NAME, ...) void(__cdecl * NAME)(__VA_ARGS__)
-#define RIVE_DELEGATE_INTPTR(NAME, ...) intptr_t(__cdecl* NAME)(__VA_ARGS__)
-#define RIVE_DELEGATE_INT32(NAME, ...) int32_t(__cdecl* NAME)(__VA_ARGS__)
+#define RIVE_DELEGATE_VOID(NAME, ...) void(RIVE_CDECL * NAME)(__VA_ARGS__)
+#define RIVE_DELEGATE_INTPTR(NAME, ...) intptr_t(RIVE_CDECL* NAME)(__VA_ARGS__)
+#define RIVE_DELEGATE_INT32(NAME, ...) int32_t(RIVE_CDECL* NAME)(__VA_ARGS__)
+
+// Reverse P/Invoke counters, by delegate struct, for benchmarking. Must match
+// ManagedCallKind in InteropStats.cs.
+enum class ManagedCallKind : int32_t
+{
+    renderPath,
+    renderImage,
+    renderPaint,
+    renderer,
+    factory,
+    scene,
+    count
+};
+
+// Every individual reverse P/Invoke, grouped by delegate struct. Must match
+// ManagedDelegate in InteropStats.cs.
+enum class ManagedDelegate : int32_t
+{
+    releaseRefs,
+    renderPathCommit,
+    renderImageWidth,
+    renderImageHeight,
+    renderPaintStyle,
+    renderPaintColor,
+    renderPaintLinearGradient,
+    renderPaintRadialGradient,
+    renderPaintThickness,
+    renderPaintJoin,
+    renderPaintCap,
+    renderPaintBlendMode,
+    renderBufferRelease,
+    rendererSave,
+    rendererRestore,
+    rendererTransform,
+    rendererDrawPath,
+    rendererClipPath,
+    rendererDrawImage,
+    rendererDrawImageMesh,
+    rendererDrawCommands,
+    factoryRelease,
+    factoryMakeRenderPath,
+    factoryMakeEmptyRenderPath,
+    factoryMakeRenderPaint,
+    factoryDecodeImage,
+    sceneFrameReady,
+    count
+};
+
+// The struct each delegate lives in, indexed by ManagedDelegate.
+static constexpr ManagedCallKind s_delegateKinds[] = {
+    ManagedCallKind::factory,     ManagedCallKind::renderPath,
+    ManagedCallKind::renderImage, ManagedCallKind::renderImage,
+    ManagedCallKind::renderPaint, ManagedCallKind::renderPaint,
+    ManagedCallKind::renderPaint, ManagedCallKind::renderPaint,
+    ManagedCallKind::renderPaint, ManagedCallKind::renderPaint,
+    ManagedCallKind::renderPaint, ManagedCallKind::renderPaint,
+    ManagedCallKind::factory,     ManagedCallKind::renderer,
+    ManagedCallKind::renderer,    ManagedCallKind::renderer,
+    ManagedCallKind::renderer,    ManagedCallKind::renderer,
+    ManagedCallKind::renderer,    ManagedCallKind::renderer,
+    ManagedCallKind::renderer,    ManagedCallKind::factory,
+    ManagedCallKind::factory,     ManagedCallKind::factory,
+    ManagedCallKind::factory,     ManagedCallKind::factory,
+    ManagedCallKind::scene,
+};
+static_assert(sizeof(s_delegateKinds) / sizeof(*s_delegateKinds) ==
+                  (size_t)ManagedDelegate::count,
+              "s_delegateKinds must cover every ManagedDelegate");
+
+static std::atomic<int64_t> s_managedCalls[(size_t)ManagedCallKind::count];
+
+// Work done at the interop boundary on behalf of one NativeScene. Must match
+// FrameStats in InteropStats.cs.
+struct FrameStats
+{
+    int64_t managedCalls[(size_t)ManagedCallKind::count];
+    // Verbs sent to managed paths.
+    int64_t pathVerbs;
+    int64_t gradients;
+    int64_t images;
+    // Vertices handed to managed drawImageMesh.
+    int64_t meshVertices;
+    int64_t advanceNanoseconds;
+    int64_t drawNanoseconds;
+    // The same calls as managedCalls, broken down by individual delegate.
+    int64_t delegateCalls[(size_t)ManagedDelegate::count];
+
+    FrameStats& operator+=(const FrameStats& other)
+    {
+        for (size_t i = 0; i < (size_t)ManagedCallKind::count; ++i)
+        {
+            managedCalls[i] += other.managedCalls[i];
+        }
+        for (size_t i = 0; i < (size_t)ManagedDelegate::count; ++i)
+        {
+            delegateCalls[i] += other.delegateCalls[i];
+        }
+        pathVerbs += other.pathVerbs;
+        gradients += other.gradients;
+        images += other.images;
+        meshVertices += other.meshVertices;
+        advanceNanoseconds += other.advanceNanoseconds;
+        drawNanoseconds += other.drawNanoseconds;
+        return *this;
+    }
+};
+
+// The stats of the scene currently advancing or drawing on this thread, if
+// any.
+static thread_local FrameStats* t_frameStats = nullptr;
+
+static void CountManagedCall(ManagedDelegate delegate)
+{
+    auto kind = s_delegateKinds[(size_t)delegate];
+    s_managedCalls[(size_t)kind].fetch_add(1, std::memory_order_relaxed);
+    if (t_frameStats)
+    {
+        ++t_frameStats->managedCalls[(size_t)kind];
+        ++t_frameStats->delegateCalls[(size_t)delegate];
+    }
+}
+
+// 64-bit FNV-1a. Pass the previous result as hash to hash multiple ranges.
+static uint64_t HashBytes(const void* data,
+                          size_t length,
+                          uint64_t hash = 0xcbf29ce484222325ull)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// A 128-bit digest of a whole file's contents, strong enough to key caches on
+// without keeping a copy of the contents around to confirm hits.
+struct ContentDigest
+{
+    uint64_t h1;
+    uint64_t h2;
+    bool operator==(const ContentDigest& other) const
+    {
+        return h1 == other.h1 && h2 == other.h2;
+    }
+};
+
+static uint64_t RotateLeft(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t FinalMix(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+// MurmurHash3 x64_128, which hashes several bytes per cycle (FNV-1a manages
+// about one), so digesting a large file on load stays cheap.
+static ContentDigest DigestBytes(const uint8_t* data, size_t length)
+{
+    constexpr uint64_t c1 = 0x87c37b91114253d5ull;
+    constexpr uint64_t c2 = 0x4cf5ad432745937full;
+    uint64_t h1 = 0, h2 = 0;
+    auto mixK1 = [&](uint64_t k1) {
+        k1 *= c1;
+        k1 = RotateLeft(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    };
+    auto mixK2 = [&](uint64_t k2) {
+        k2 *= c2;
+        k2 = RotateLeft(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    };
+    size_t blockCount = length / 16;
+    for (size_t i = 0; i < blockCount; ++i)
+    {
+        uint64_t k1, k2;
+        memcpy(&k1, data + i * 16, 8);
+        memcpy(&k2, data + i * 16 + 8, 8);
+        mixK1(k1);
+        h1 = RotateLeft(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+        mixK2(k2);
+        h2 = RotateLeft(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+    size_t tailLength = length & 15;
+    if (tailLength)
+    {
+        uint8_t tail[16] = {};
+        memcpy(tail, data + blockCount * 16, tailLength);
+        uint64_t k1, k2;
+        memcpy(&k1, tail, 8);
+        memcpy(&k2, tail + 8, 8);
+        if (tailLength > 8)
+        {
+            mixK2(k2);
+        }
+        mixK1(k1);
+    }
+    h1 ^= length;
+    h2 ^= length;
+    h1 += h2;
+    h2 += h1;
+    h1 = FinalMix(h1);
+    h2 = FinalMix(h2);
+    h1 += h2;
+    h2 += h1;
+    return {h1, h2};
+}
+
+static void CountFrameStat(int64_t FrameStats::*stat, int64_t n = 1)
+{
+    if (t_frameStats)
+    {
+        t_frameStats->*stat += n;
+    }
+}
+
+// Attributes everything counted on this thread to stats, and adds the elapsed
+// time to stats->*timer, for the lifetime of the scope.
+class FrameStatsScope
+{
+public:
+    FrameStatsScope(FrameStats* stats, int64_t FrameStats::*timer) :
+        m_stats(stats),
+        m_timer(timer),
+        m_previous(t_frameStats),
+        m_start(std::chrono::steady_clock::now())
+    {
+        t_frameStats = stats;
+    }
+    FrameStatsScope(const FrameStatsScope&) = delete;
+    FrameStatsScope& operator=(const FrameStatsScope&) = delete;
+
+    ~FrameStatsScope()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_stats->*m_timer +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count();
+        t_frameStats = m_previous;
+    }
+
+private:
+    FrameStats* const m_stats;
+    int64_t FrameStats::*const m_timer;
+    FrameStats* const m_previous;
+    const std::chrono::steady_clock::time_point m_start;
+};
+
+// Copies up to maxCount counters into counts. Returns the number of counters.
+RIVE_DLL_INT32 Interop_GetCallCounts(int64_t* counts, int32_t maxCount)
+{
+    int32_t n = (int32_t)ManagedCallKind::count;
+    for (int32_t i = 0; i < std::min(n, maxCount); ++i)
+    {
+        counts[i] = s_managedCalls[i].load(std::memory_order_relaxed);
+    }
+    return n;
+}
+
+RIVE_DLL_VOID Interop_ResetCallCounts()
+{
+    for (auto& counter : s_managedCalls)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -85,6 +390,176 @@ RIVE_DLL_VOID CopyU16Array(intptr_t sourceArray,
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Fixed-size block allocator for the small, numerous interop wrappers. Blocks
+// are carved out of 64KB slabs and recycled through a free list, so loading a
+// big file makes a handful of large allocations instead of one per path or
+// paint. When the last block is freed, all but one slab go back to the system
+// at once.
+template <size_t BlockSize> class SlabPool
+{
+public:
+    static SlabPool* Instance()
+    {
+        static SlabPool* pool = new SlabPool();
+        return pool;
+    }
+
+    void* allocate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_freeList)
+        {
+            grow();
+        }
+        FreeBlock* block = m_freeList;
+        m_freeList = block->next;
+        ++m_liveCount;
+        return block;
+    }
+
+    void deallocate(void* ptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_liveCount == 0 && m_slabs.size() > 1)
+        {
+            // Keep one slab so a lone object that keeps getting recreated
+            // doesn't allocate a slab every time.
+            m_slabs.resize(1);
+            m_freeList = nullptr;
+            carve(m_slabs[0].get());
+            return;
+        }
+        auto block = static_cast<FreeBlock*>(ptr);
+        block->next = m_freeList;
+        m_freeList = block;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    // Rounded up so every block in a slab stays maximally aligned.
+    static constexpr size_t kAlign = alignof(std::max_align_t);
+    static constexpr size_t kBlockBytes =
+        (std::max(BlockSize, sizeof(FreeBlock)) + kAlign - 1) & ~(kAlign - 1);
+    static constexpr size_t kSlabBytes = 64 * 1024;
+    static constexpr size_t kBlocksPerSlab = kSlabBytes / kBlockBytes;
+    static_assert(kBlocksPerSlab > 0, "block too large for a slab");
+
+    void grow()
+    {
+        m_slabs.emplace_back(new uint8_t[kBlocksPerSlab * kBlockBytes]);
+        carve(m_slabs.back().get());
+    }
+
+    // Pushes all of slab's blocks onto the free list.
+    void carve(uint8_t* slab)
+    {
+        for (size_t i = kBlocksPerSlab; i-- > 0;)
+        {
+            auto block = reinterpret_cast<FreeBlock*>(slab + i * kBlockBytes);
+            block->next = m_freeList;
+            m_freeList = block;
+        }
+    }
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<uint8_t[]>> m_slabs;
+    FreeBlock* m_freeList = nullptr;
+    size_t m_liveCount = 0;
+};
+
+// Routes new/delete of T (which must be the most derived type) through a
+// SlabPool sized for it.
+template <typename T> struct SlabAllocated
+{
+    static void* operator new(size_t size)
+    {
+        assert(size == sizeof(T));
+        return SlabPool<sizeof(T)>::Instance()->allocate();
+    }
+    static void operator delete(void* ptr)
+    {
+        SlabPool<sizeof(T)>::Instance()->deallocate(ptr);
+    }
+};
+
+// Collects the managed refs of destroyed wrappers and hands them back to
+// managed code in batches, instead of making one reverse P/Invoke per object.
+// Tearing down a file or artboard releases thousands of paths and paints at
+// once. Exports that can destroy wrappers call Flush() before returning.
+class ManagedRefReleaser
+{
+public:
+    struct Delegates
+    {
+        RIVE_DELEGATE_VOID(releaseRefs, const intptr_t* refs, int32_t count);
+    };
+
+    static Delegates s_delegates;
+
+    // Don't hold on to more than this many managed objects between flushes.
+    static constexpr size_t kMaxPending = 4096;
+
+    static void Release(intptr_t ref)
+    {
+        bool full;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_pending.push_back(ref);
+            full = s_pending.size() >= kMaxPending;
+        }
+        if (full)
+        {
+            Flush();
+        }
+    }
+
+    static void Flush()
+    {
+        std::vector<intptr_t> refs;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            if (s_pending.empty())
+            {
+                return;
+            }
+            refs.swap(s_pending);
+            // Keep the allocation around for the next batch.
+            s_pending.swap(s_spare);
+        }
+        CountManagedCall(ManagedDelegate::releaseRefs);
+        s_delegates.releaseRefs(refs.data(), (int32_t)refs.size());
+        refs.clear();
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_spare.swap(refs);
+    }
+
+private:
+    static std::mutex s_mutex;
+    static std::vector<intptr_t> s_pending;
+    static std::vector<intptr_t> s_spare;
+};
+
+ManagedRefReleaser::Delegates ManagedRefReleaser::s_delegates{};
+std::mutex ManagedRefReleaser::s_mutex;
+std::vector<intptr_t> ManagedRefReleaser::s_pending;
+std::vector<intptr_t> ManagedRefReleaser::s_spare;
+
+RIVE_DLL_VOID
+Interop_RegisterDelegates(ManagedRefReleaser::Delegates delegates)
+{
+    ManagedRefReleaser::s_delegates = delegates;
+}
+
+RIVE_DLL_VOID Interop_FlushReleases() { ManagedRefReleaser::Flush(); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// RiveSharp does this math in managed code now. These remain as the reference
+// that MathValidation in Benchmarks checks it against.
 RIVE_DLL_VOID Mat2D_Multiply(Mat2D a, Mat2D b, Mat2D* out) { *out = a * b; }
 RIVE_DLL_VOID Mat2D_MultiplyVec2D(Mat2D a, Vec2D b, Vec2D* out)
 {
@@ -94,81 +569,132 @@ RIVE_DLL_INT8_BOOL Mat2D_Invert(Mat2D a, Mat2D* out) { return a.invert(out); }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class RenderPathSharp : public RenderPath
+// Accumulates path geometry natively in a RawPath and mirrors it to the managed
+// RenderPath in one bulk commit (instead of one reverse P/Invoke per verb) the
+// next time the path is drawn.
+class RenderPathSharp : public RenderPath,
+                        public SlabAllocated<RenderPathSharp>
 {
 public:
     struct Delegates
     {
-        RIVE_DELEGATE_VOID(release, intptr_t ref);
-        RIVE_DELEGATE_VOID(rewind, intptr_t ref);
-        RIVE_DELEGATE_VOID(addRenderPath,
-                           intptr_t ref,
-                           intptr_t path,
-                           float,
-                           float,
-                           float,
-                           float,
-                           float,
-                           float);
-        RIVE_DELEGATE_VOID(fillRule, intptr_t ref, int rule);
-        RIVE_DELEGATE_VOID(moveTo, intptr_t ref, float x, float y);
-        RIVE_DELEGATE_VOID(lineTo, intptr_t ref, float x, float y);
-        RIVE_DELEGATE_VOID(quadTo,
+        RIVE_DELEGATE_VOID(commit,
                            intptr_t ref,
-                           float ox,
-                           float oy,
-                           float x,
-                           float y);
-        RIVE_DELEGATE_VOID(cubicTo,
-                           intptr_t ref,
-                           float ox,
-                           float oy,
-                           float ix,
-                           float iy,
-                           float x,
-                           float y);
-        RIVE_DELEGATE_VOID(close, intptr_t ref);
+                           const Vec2D* pts,
+                           int nPts,
+                           const uint8_t* verbs, // PathVerb[nVerbs]
+                           int nVerbs,
+                           int fillRule);
     };
 
     static Delegates s_delegates;
+    // Every call into managed code goes through callbacks() to be counted.
+    static const Delegates& callbacks(ManagedDelegate delegate)
+    {
+        CountManagedCall(delegate);
+        return s_delegates;
+    }
 
     RenderPathSharp(intptr_t managedRef) : m_ref(managedRef) {}
+    // The managed object was already built from rawPath.
+    RenderPathSharp(intptr_t managedRef,
+                    const RawPath& rawPath,
+                    FillRule fillRule) :
+        m_ref(managedRef), m_fillRule(fillRule), m_dirty(false)
+    {
+        m_rawPath.addPath(rawPath);
+    }
     RenderPathSharp(const RenderPathSharp&) = delete;
     RenderPathSharp& operator=(const RenderPathSharp&) = delete;
-    ~RenderPathSharp() { s_delegates.release(m_ref); };
+    ~RenderPathSharp() { ManagedRefReleaser::Release(m_ref); }
 
-    void rewind() override { s_delegates.rewind(m_ref); }
+    void rewind() override
+    {
+        m_rawPath.rewind();
+        markChanged();
+    }
     void fillRule(FillRule value) override
     {
-        s_delegates.fillRule(m_ref, (int)value);
+        if (m_fillRule != value)
+        {
+            m_fillRule = value;
+            markChanged();
+        }
     }
     void addRenderPath(RenderPath* path, const Mat2D& m) override
     {
-        s_delegates.addRenderPath(m_ref,
-                                  static_cast<RenderPathSharp*>(path)->m_ref,
-                                  m.xx(),
-                                  m.xy(),
-                                  m.yx(),
-                                  m.yy(),
-                                  m.tx(),
-                                  m.ty());
-    }
-    void moveTo(float x, float y) override { s_delegates.moveTo(m_ref, x, y); }
-    void lineTo(float x, float y) override { s_delegates.lineTo(m_ref, x, y); }
+        m_rawPath.addPath(static_cast<RenderPathSharp*>(path)->m_rawPath, &m);
+        markChanged();
+    }
+    void moveTo(float x, float y) override
+    {
+        m_rawPath.moveTo(x, y);
+        markChanged();
+    }
+    void lineTo(float x, float y) override
+    {
+        m_rawPath.lineTo(x, y);
+        markChanged();
+    }
     void cubicTo(float ox, float oy, float ix, float iy, float x, float y)
         override
     {
-        s_delegates.cubicTo(m_ref, ox, oy, ix, iy, x, y);
+        m_rawPath.cubicTo(ox, oy, ix, iy, x, y);
+        markChanged();
+    }
+    void close() override
+    {
+        m_rawPath.close();
+        markChanged();
     }
-    void close() override { s_delegates.close(m_ref); }
 
     // not an override, but needed for makeRenderPath
     void quadTo(float ox, float oy, float x, float y)
     {
-        s_delegates.quadTo(m_ref, ox, oy, x, y);
+        m_rawPath.quadTo(ox, oy, x, y);
+        markChanged();
+    }
+
+    const RawPath& rawPath() const { return m_rawPath; }
+    FillRule fillRuleValue() const { return m_fillRule; }
+
+    // Incremented whenever the geometry or fill rule changes.
+    uint32_t version() const { return m_version; }
+
+    // True if the managed path is out of date with m_rawPath.
+    bool dirty() const { return m_dirty; }
+    void markCommitted() { m_dirty = false; }
+
+    // Brings the managed path up to date, if needed.
+    void commit()
+    {
+        if (m_dirty)
+        {
+            CountFrameStat(&FrameStats::pathVerbs, m_rawPath.verbs().size());
+            callbacks(ManagedDelegate::renderPathCommit).commit(
+                m_ref,
+                m_rawPath.points().data(),
+                (int)m_rawPath.points().size(),
+                reinterpret_cast<const uint8_t*>(m_rawPath.verbs().data()),
+                (int)m_rawPath.verbs().size(),
+                (int)m_fillRule);
+            m_dirty = false;
+        }
     }
 
     const intptr_t m_ref;
+
+private:
+    void markChanged()
+    {
+        m_dirty = true;
+        ++m_version;
+    }
+
+    RawPath m_rawPath;
+    FillRule m_fillRule = FillRule::nonZero;
+    bool m_dirty = true;
+    uint32_t m_version = 0;
 };
 
 RenderPathSharp::Delegates RenderPathSharp::s_delegates{};
@@ -180,26 +706,31 @@ RIVE_DLL_VOID RenderPath_RegisterDelegates(RenderPathSharp::Delegates delegates)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class RenderImageSharp : public RenderImage
+class RenderImageSharp : public RenderImage,
+                         public SlabAllocated<RenderImageSharp>
 {
 public:
     struct Delegates
     {
-        RIVE_DELEGATE_VOID(release, intptr_t ref);
         RIVE_DELEGATE_INT32(width, intptr_t ref);
         RIVE_DELEGATE_INT32(height, intptr_t ref);
     };
 
     static Delegates s_delegates;
+    static const Delegates& callbacks(ManagedDelegate delegate)
+    {
+        CountManagedCall(delegate);
+        return s_delegates;
+    }
 
     RenderImageSharp(intptr_t managedRef) : m_ref(managedRef)
     {
-        m_Width = s_delegates.width(m_ref);
-        m_Height = s_delegates.height(m_ref);
+        m_Width = callbacks(ManagedDelegate::renderImageWidth).width(m_ref);
+        m_Height = callbacks(ManagedDelegate::renderImageHeight).height(m_ref);
     }
     RenderImageSharp(const RenderImageSharp&) = delete;
     RenderImageSharp& operator=(const RenderImageSharp&) = delete;
-    ~RenderImageSharp() { s_delegates.release(m_ref); };
+    ~RenderImageSharp() { ManagedRefReleaser::Release(m_ref); }
 
     const intptr_t m_ref;
 };
@@ -214,16 +745,17 @@ RIVE_DLL_VOID RenderImage_RegisterDelegates(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class RenderPaintSharp : public RenderPaint
+class RenderPaintSharp : public RenderPaint,
+                         public SlabAllocated<RenderPaintSharp>
 {
 public:
     struct Delegates
     {
-        RIVE_DELEGATE_VOID(release, intptr_t ref);
         RIVE_DELEGATE_VOID(style, intptr_t ref, int style);
         RIVE_DELEGATE_VOID(color, intptr_t ref, uint32_t color);
         RIVE_DELEGATE_VOID(linearGradient,
                            intptr_t ref,
+                           uint32_t id,
                            float sx,
                            float sy,
                            float ex,
@@ -233,6 +765,7 @@ public:
                            int count);
         RIVE_DELEGATE_VOID(radialGradient,
                            intptr_t ref,
+                           uint32_t id,
                            float cx,
                            float cy,
                            float radius,
@@ -246,105 +779,188 @@ public:
     };
 
     static Delegates s_delegates;
+    static const Delegates& callbacks(ManagedDelegate delegate)
+    {
+        CountManagedCall(delegate);
+        return s_delegates;
+    }
 
     RenderPaintSharp(intptr_t managedRef) : m_ref(managedRef) {}
     RenderPaintSharp(const RenderPaintSharp&) = delete;
     RenderPaintSharp& operator=(const RenderPaintSharp&) = delete;
-    ~RenderPaintSharp() { s_delegates.release(m_ref); };
-
-    struct Shader : public RenderShader
-    {
-        virtual void apply(intptr_t) const = 0;
-    };
+    ~RenderPaintSharp() { ManagedRefReleaser::Release(m_ref); }
 
-    struct LinearGradientShader : public Shader
+    // Gradients are immutable and deduplicated by content (see GradientCache),
+    // so the id identifies the gradient's contents: a paint can skip
+    // re-applying the shader it already has, and the managed side keys its
+    // SKShader cache on it.
+    struct GradientShader : public RenderShader
     {
-        LinearGradientShader(float sx,
-                             float sy,
-                             float ex,
-                             float ey,
-                             const uint32_t colors[],
-                             const float stops[],
-                             int n) :
-            sx(sx),
-            sy(sy),
-            ex(ex),
-            ey(ey),
+        enum class Type
+        {
+            linear,
+            radial,
+        };
+
+        // geometry is {sx, sy, ex, ey} for linear gradients and
+        // {cx, cy, radius, 0} for radial gradients.
+        GradientShader(Type type,
+                       const float geometry[4],
+                       const uint32_t colors[],
+                       const float stops[],
+                       int n,
+                       uint32_t id) :
+            type(type),
+            geometry{geometry[0], geometry[1], geometry[2], geometry[3]},
             colors(colors, colors + n),
-            stops(stops, stops + n)
+            stops(stops, stops + n),
+            id(id)
         {}
-        void apply(intptr_t ref) const override
-        {
-            s_delegates.linearGradient(ref,
-                                       sx,
-                                       sy,
-                                       ex,
-                                       ey,
-                                       colors.data(),
-                                       stops.data(),
-                                       (int)colors.size());
-        }
-        const float sx, sy;
-        const float ex, ey;
-        const std::vector<uint32_t> colors;
-        const std::vector<float> stops;
-    };
 
-    struct RadialGradientShader : public Shader
-    {
-        RadialGradientShader(float cx,
-                             float cy,
-                             float radius,
-                             const uint32_t colors[],
-                             const float stops[],
-                             int n) :
-            cx(cx),
-            cy(cy),
-            radius(radius),
-            colors(colors, colors + n),
-            stops(stops, stops + n)
-        {}
-        void apply(intptr_t ref) const override
-        {
-            s_delegates.radialGradient(ref,
-                                       cx,
-                                       cy,
-                                       radius,
-                                       colors.data(),
-                                       stops.data(),
-                                       (int)colors.size());
-        }
-        const float cx, cy;
-        const float radius;
+        bool equals(Type otherType,
+                    const float otherGeometry[4],
+                    const uint32_t otherColors[],
+                    const float otherStops[],
+                    int n) const
+        {
+            return type == otherType && (int)colors.size() == n &&
+                   std::equal(geometry, geometry + 4, otherGeometry) &&
+                   std::equal(colors.begin(), colors.end(), otherColors) &&
+                   std::equal(stops.begin(), stops.end(), otherStops);
+        }
+
+        void apply(intptr_t ref) const
+        {
+            if (type == Type::linear)
+            {
+                callbacks(ManagedDelegate::renderPaintLinearGradient)
+                    .linearGradient(ref,
+                                    id,
+                                    geometry[0],
+                                    geometry[1],
+                                    geometry[2],
+                                    geometry[3],
+                                    colors.data(),
+                                    stops.data(),
+                                    (int)colors.size());
+            }
+            else
+            {
+                callbacks(ManagedDelegate::renderPaintRadialGradient)
+                    .radialGradient(ref,
+                                    id,
+                                    geometry[0],
+                                    geometry[1],
+                                    geometry[2],
+                                    colors.data(),
+                                    stops.data(),
+                                    (int)colors.size());
+            }
+        }
+
+        const Type type;
+        const float geometry[4];
         const std::vector<uint32_t> colors;
         const std::vector<float> stops;
+        const uint32_t id;
     };
 
+    // Setting a property to the value it already has is a no-op: it neither
+    // calls into managed code nor bumps the version (which DirtyTracker would
+    // report as a change).
     void style(RenderPaintStyle style) override
     {
-        s_delegates.style(m_ref, (int)style);
+        if (m_style != style)
+        {
+            m_style = style;
+            ++m_version;
+            callbacks(ManagedDelegate::renderPaintStyle)
+                .style(m_ref, (int)style);
+        }
+    }
+    void color(uint32_t value) override
+    {
+        if (m_color != value)
+        {
+            m_color = value;
+            ++m_version;
+            callbacks(ManagedDelegate::renderPaintColor).color(m_ref, value);
+        }
     }
-    void color(uint32_t value) override { s_delegates.color(m_ref, value); }
     void thickness(float value) override
     {
-        s_delegates.thickness(m_ref, value);
+        if (m_thickness != value)
+        {
+            m_thickness = value;
+            ++m_version;
+            callbacks(ManagedDelegate::renderPaintThickness)
+                .thickness(m_ref, value);
+        }
     }
     void join(StrokeJoin value) override
     {
-        s_delegates.join(m_ref, (int)value);
+        if (m_join != value)
+        {
+            m_join = value;
+            ++m_version;
+            callbacks(ManagedDelegate::renderPaintJoin)
+                .join(m_ref, (int)value);
+        }
+    }
+    void cap(StrokeCap value) override
+    {
+        if (m_cap != value)
+        {
+            m_cap = value;
+            ++m_version;
+            callbacks(ManagedDelegate::renderPaintCap).cap(m_ref, (int)value);
+        }
     }
-    void cap(StrokeCap value) override { s_delegates.cap(m_ref, (int)value); }
     void blendMode(BlendMode value) override
     {
-        s_delegates.blendMode(m_ref, (int)value);
+        if (m_blendMode != value)
+        {
+            m_blendMode = value;
+            ++m_version;
+            callbacks(ManagedDelegate::renderPaintBlendMode)
+                .blendMode(m_ref, (int)value);
+        }
     }
     void shader(rcp<RenderShader> shader) override
     {
-        ((Shader*)shader.get())->apply(m_ref);
+        auto gradient = static_cast<const GradientShader*>(shader.get());
+        uint32_t id = gradient ? gradient->id : 0;
+        if (id != m_shaderID)
+        {
+            m_shaderID = id;
+            ++m_version;
+            if (gradient)
+            {
+                gradient->apply(m_ref);
+            }
+        }
     }
     void invalidateStroke() override {}
 
+    // Incremented whenever any property changes.
+    uint32_t version() const { return m_version; }
+    bool isStroke() const { return m_style == RenderPaintStyle::stroke; }
+    float thicknessValue() const { return m_thickness.value_or(1); }
+
     const intptr_t m_ref;
+
+private:
+    // Id of the gradient last applied to the managed paint, or 0.
+    uint32_t m_shaderID = 0;
+    uint32_t m_version = 0;
+    // The values last sent to the managed paint. Empty until the first set,
+    // since the managed paint's defaults aren't rive's.
+    std::optional<RenderPaintStyle> m_style;
+    std::optional<uint32_t> m_color;
+    std::optional<float> m_thickness;
+    std::optional<StrokeJoin> m_join;
+    std::optional<StrokeCap> m_cap;
+    std::optional<BlendMode> m_blendMode;
 };
 
 RenderPaintSharp::Delegates RenderPaintSharp::s_delegates{};
@@ -357,71 +973,171 @@ RIVE_DLL_VOID RenderPaint_RegisterDelegates(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class RendererSharp : public Renderer
+// DataRenderBuffer with an identity, so the managed renderer can mirror static
+// mesh data (UVs and indices) once and only refresh it when the buffer gets
+// rewritten, instead of copying it on every draw.
+class RenderBufferSharp : public DataRenderBuffer
 {
 public:
     struct Delegates
     {
-        RIVE_DELEGATE_VOID(save, intptr_t ref);
-        RIVE_DELEGATE_VOID(restore, intptr_t ref);
-        RIVE_DELEGATE_VOID(transform,
-                           intptr_t ref,
-                           float,
-                           float,
-                           float,
-                           float,
-                           float,
-                           float);
-        RIVE_DELEGATE_VOID(drawPath,
-                           intptr_t ref,
-                           intptr_t path,
-                           intptr_t paint);
-        RIVE_DELEGATE_VOID(clipPath, intptr_t ref, intptr_t path);
-        RIVE_DELEGATE_VOID(drawImage,
-                           intptr_t ref,
-                           intptr_t image,
-                           int blendMode,
-                           float opacity);
-        RIVE_DELEGATE_VOID(drawImageMesh,
-                           intptr_t ref,
-                           intptr_t image,
+        RIVE_DELEGATE_VOID(release, uint32_t id);
+    };
+
+    static Delegates s_delegates;
+    static const Delegates& callbacks(ManagedDelegate delegate)
+    {
+        CountManagedCall(delegate);
+        return s_delegates;
+    }
+
+    RenderBufferSharp(RenderBufferType type,
+                      RenderBufferFlags flags,
+                      size_t sizeInBytes) :
+        DataRenderBuffer(type, flags, sizeInBytes), m_id(++s_lastID)
+    {}
+    RenderBufferSharp(const RenderBufferSharp&) = delete;
+    RenderBufferSharp& operator=(const RenderBufferSharp&) = delete;
+    ~RenderBufferSharp()
+    {
+        if (m_mirrored.load(std::memory_order_relaxed))
+        {
+            callbacks(ManagedDelegate::renderBufferRelease).release(m_id);
+        }
+    }
+
+    uint32_t id() const { return m_id; }
+
+    // Incremented every time the contents are rewritten (map/unmap).
+    uint32_t version() const
+    {
+        return m_version.load(std::memory_order_acquire);
+    }
+
+    // Records that managed code may hold a copy of this buffer, which it
+    // needs to be told to drop when the buffer goes away.
+    void markMirrored() { m_mirrored.store(true, std::memory_order_relaxed); }
+
+protected:
+    void onUnmap() override
+    {
+        DataRenderBuffer::onUnmap();
+        m_version.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    static std::atomic<uint32_t> s_lastID;
+
+    const uint32_t m_id;
+    std::atomic<uint32_t> m_version{0};
+    std::atomic<bool> m_mirrored{false};
+};
+
+RenderBufferSharp::Delegates RenderBufferSharp::s_delegates{};
+std::atomic<uint32_t> RenderBufferSharp::s_lastID{0};
+
+RIVE_DLL_VOID
+RenderBuffer_RegisterDelegates(RenderBufferSharp::Delegates delegates)
+{
+    RenderBufferSharp::s_delegates = delegates;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class RendererSharp : public Renderer
+{
+public:
+    struct Delegates
+    {
+        RIVE_DELEGATE_VOID(save, intptr_t ref);
+        RIVE_DELEGATE_VOID(restore, intptr_t ref);
+        RIVE_DELEGATE_VOID(transform,
+                           intptr_t ref,
+                           float,
+                           float,
+                           float,
+                           float,
+                           float,
+                           float);
+        RIVE_DELEGATE_VOID(drawPath,
+                           intptr_t ref,
+                           intptr_t path,
+                           intptr_t paint);
+        RIVE_DELEGATE_VOID(clipPath, intptr_t ref, intptr_t path);
+        RIVE_DELEGATE_VOID(drawImage,
+                           intptr_t ref,
+                           intptr_t image,
+                           int blendMode,
+                           float opacity);
+        // texcoords are normalized. Managed code keeps denormalized copies of
+        // the texcoords and indices, and only reads them again when their
+        // buffer's id or version changes.
+        RIVE_DELEGATE_VOID(drawImageMesh,
+                           intptr_t ref,
+                           intptr_t image,
                            const float* vertices,
                            const float* texcoords,
+                           uint32_t texcoordsID,
+                           uint32_t texcoordsVersion,
                            int vertexCount,
                            const uint16_t* indices,
+                           uint32_t indicesID,
+                           uint32_t indicesVersion,
                            int indexCount,
                            int blendMode,
                            float opacity);
+        RIVE_DELEGATE_VOID(drawCommands,
+                           intptr_t ref,
+                           const uint8_t* commands,
+                           int32_t nBytes);
     };
 
     static Delegates s_delegates;
+    static const Delegates& callbacks(ManagedDelegate delegate)
+    {
+        CountManagedCall(delegate);
+        return s_delegates;
+    }
 
     RendererSharp(intptr_t managedRef) : m_ref(managedRef) {}
     RendererSharp(const RendererSharp&) = delete;
     RendererSharp& operator=(const RendererSharp&) = delete;
 
-    void save() override { s_delegates.save(m_ref); }
-    void restore() override { s_delegates.restore(m_ref); }
+    void save() override
+    {
+        callbacks(ManagedDelegate::rendererSave).save(m_ref);
+    }
+    void restore() override
+    {
+        callbacks(ManagedDelegate::rendererRestore).restore(m_ref);
+    }
     void transform(const Mat2D& m) override
     {
-        s_delegates
+        callbacks(ManagedDelegate::rendererTransform)
             .transform(m_ref, m.xx(), m.xy(), m.yx(), m.yy(), m.tx(), m.ty());
     }
     void drawPath(RenderPath* path, RenderPaint* paint) override
     {
-        s_delegates.drawPath(m_ref,
-                             static_cast<RenderPathSharp*>(path)->m_ref,
-                             static_cast<RenderPaintSharp*>(paint)->m_ref);
+        auto sharpPath = static_cast<RenderPathSharp*>(path);
+        sharpPath->commit();
+        callbacks(ManagedDelegate::rendererDrawPath)
+            .drawPath(m_ref,
+                      sharpPath->m_ref,
+                      static_cast<RenderPaintSharp*>(paint)->m_ref);
     }
     void clipPath(RenderPath* path) override
     {
-        s_delegates.clipPath(m_ref, static_cast<RenderPathSharp*>(path)->m_ref);
+        auto sharpPath = static_cast<RenderPathSharp*>(path);
+        sharpPath->commit();
+        callbacks(ManagedDelegate::rendererClipPath)
+            .clipPath(m_ref, sharpPath->m_ref);
     }
     void drawImage(const RenderImage* image,
                    BlendMode blendMode,
                    float opacity) override
     {
-        s_delegates.drawImage(
+        CountFrameStat(&FrameStats::images);
+        callbacks(ManagedDelegate::rendererDrawImage).drawImage(
             m_ref,
             static_cast<const RenderImageSharp*>(image)->m_ref,
             (int)blendMode,
@@ -441,27 +1157,24 @@ public:
         assert(uvCoords_f32->sizeInBytes() == vertexCount * sizeof(Vec2D));
         assert(indices_u16->sizeInBytes() == indexCount * sizeof(uint16_t));
 
-        // The local matrix is ignored for SkCanvas::drawVertices, so we have to
-        // manually scale the UVs to match Skia's convention.
-        float w = (float)image->width();
-        float h = (float)image->height();
-        int n = vertexCount * 2;
-        const float* uvs =
-            static_cast<DataRenderBuffer*>(uvCoords_f32.get())->f32s();
-        std::vector<float> denormUVs(n);
-        for (int i = 0; i < n; i += 2)
-        {
-            denormUVs[i] = uvs[i] * w;
-            denormUVs[i + 1] = uvs[i + 1] * h;
-        }
+        CountFrameStat(&FrameStats::images);
+        CountFrameStat(&FrameStats::meshVertices, vertexCount);
 
-        s_delegates.drawImageMesh(
+        auto uvs = static_cast<RenderBufferSharp*>(uvCoords_f32.get());
+        auto indices = static_cast<RenderBufferSharp*>(indices_u16.get());
+        uvs->markMirrored();
+        indices->markMirrored();
+        callbacks(ManagedDelegate::rendererDrawImageMesh).drawImageMesh(
             m_ref,
             static_cast<const RenderImageSharp*>(image)->m_ref,
-            static_cast<DataRenderBuffer*>(vertices_f32.get())->f32s(),
-            denormUVs.data(),
+            static_cast<RenderBufferSharp*>(vertices_f32.get())->f32s(),
+            uvs->f32s(),
+            uvs->id(),
+            uvs->version(),
             vertexCount,
-            static_cast<DataRenderBuffer*>(indices_u16.get())->u16s(),
+            indices->u16s(),
+            indices->id(),
+            indices->version(),
             indexCount,
             (int)blendMode,
             opacity);
@@ -478,6 +1191,431 @@ RIVE_DLL_VOID Renderer_RegisterDelegates(RendererSharp::Delegates delegates)
     RendererSharp::s_delegates = delegates;
 }
 
+// Compact stream of Renderer calls that gets replayed in managed code with a
+// single reverse P/Invoke. Every command starts with a 32-bit opcode and is
+// padded to a multiple of 8 bytes, so the 64-bit handles are always aligned.
+// The layouts must match Renderer.DrawCommandsCallback in Renderer.cs.
+class RenderCommandBuffer
+{
+public:
+    enum class Op : uint32_t
+    {
+        save = 0,
+        restore = 1,
+        transform = 2,
+        drawPath = 3,
+        clipPath = 4,
+        drawImage = 5,
+        drawImageMesh = 6,
+        commitPath = 7,
+    };
+
+    struct SaveCommand
+    {
+        Op op;
+        uint32_t pad;
+    };
+
+    struct TransformCommand
+    {
+        Op op;
+        uint32_t pad;
+        float xx, xy, yx, yy, tx, ty;
+    };
+
+    struct DrawPathCommand
+    {
+        Op op;
+        uint32_t pad;
+        int64_t path;
+        int64_t paint;
+    };
+
+    struct ClipPathCommand
+    {
+        Op op;
+        uint32_t pad;
+        int64_t path;
+    };
+
+    struct DrawImageCommand
+    {
+        Op op;
+        int32_t blendMode;
+        int64_t image;
+        float opacity;
+        uint32_t pad;
+    };
+
+    struct DrawImageMeshCommand
+    {
+        Op op;
+        int32_t blendMode;
+        int64_t image;
+        int64_t vertices; // const float*
+        int64_t uvs;      // const float*, normalized
+        int64_t indices;  // const uint16_t*
+        int32_t vertexCount;
+        int32_t indexCount;
+        uint32_t uvsID;
+        uint32_t uvsVersion;
+        uint32_t indicesID;
+        uint32_t indicesVersion;
+        float opacity;
+        uint32_t pad;
+    };
+
+    // Updates a managed RenderPath from native geometry before it gets drawn.
+    struct CommitPathCommand
+    {
+        Op op;
+        int32_t fillRule;
+        int64_t path;
+        int64_t pts;   // const Vec2D*
+        int64_t verbs; // const uint8_t*
+        int32_t nPts;
+        int32_t nVerbs;
+    };
+
+    static_assert(sizeof(SaveCommand) == 8, "unexpected command size");
+    static_assert(sizeof(TransformCommand) == 32, "unexpected command size");
+    static_assert(sizeof(DrawPathCommand) == 24, "unexpected command size");
+    static_assert(sizeof(ClipPathCommand) == 16, "unexpected command size");
+    static_assert(sizeof(DrawImageCommand) == 24, "unexpected command size");
+    static_assert(sizeof(DrawImageMeshCommand) == 72, "unexpected command size");
+    static_assert(sizeof(CommitPathCommand) == 40, "unexpected command size");
+
+    // Begins a new frame. Keeps the existing allocation around for reuse.
+    void reset() { m_data.clear(); }
+
+    template <typename T> void push(const T& command)
+    {
+        size_t offset = m_data.size();
+        m_data.resize(offset + sizeof(T));
+        memcpy(m_data.data() + offset, &command, sizeof(T));
+    }
+
+    // Hands the entire recording to the managed renderer in one call.
+    void playback(intptr_t renderer) const
+    {
+        if (!m_data.empty())
+        {
+            RendererSharp::callbacks(ManagedDelegate::rendererDrawCommands)
+                .drawCommands(renderer,
+                              m_data.data(),
+                              (int32_t)m_data.size());
+        }
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+// Renderer that writes into a RenderCommandBuffer instead of calling into
+// managed code.
+class RecordingRenderer : public Renderer
+{
+public:
+    using Op = RenderCommandBuffer::Op;
+
+    RecordingRenderer(RenderCommandBuffer* commands) : m_commands(commands) {}
+    RecordingRenderer(const RecordingRenderer&) = delete;
+    RecordingRenderer& operator=(const RecordingRenderer&) = delete;
+
+    void save() override
+    {
+        m_commands->push(RenderCommandBuffer::SaveCommand{Op::save, 0});
+    }
+    void restore() override
+    {
+        m_commands->push(RenderCommandBuffer::SaveCommand{Op::restore, 0});
+    }
+    void transform(const Mat2D& m) override
+    {
+        m_commands->push(RenderCommandBuffer::TransformCommand{
+            Op::transform, 0, m.xx(), m.xy(), m.yx(), m.yy(), m.tx(), m.ty()});
+    }
+    void drawPath(RenderPath* path, RenderPaint* paint) override
+    {
+        auto sharpPath = static_cast<RenderPathSharp*>(path);
+        commitPath(sharpPath);
+        m_commands->push(RenderCommandBuffer::DrawPathCommand{
+            Op::drawPath,
+            0,
+            sharpPath->m_ref,
+            static_cast<RenderPaintSharp*>(paint)->m_ref});
+    }
+    void clipPath(RenderPath* path) override
+    {
+        auto sharpPath = static_cast<RenderPathSharp*>(path);
+        commitPath(sharpPath);
+        m_commands->push(RenderCommandBuffer::ClipPathCommand{Op::clipPath,
+                                                              0,
+                                                              sharpPath->m_ref});
+    }
+    void drawImage(const RenderImage* image,
+                   BlendMode blendMode,
+                   float opacity) override
+    {
+        CountFrameStat(&FrameStats::images);
+        m_commands->push(RenderCommandBuffer::DrawImageCommand{
+            Op::drawImage,
+            (int32_t)blendMode,
+            static_cast<const RenderImageSharp*>(image)->m_ref,
+            opacity,
+            0});
+    }
+    void drawImageMesh(const RenderImage* image,
+                       rcp<RenderBuffer> vertices_f32,
+                       rcp<RenderBuffer> uvCoords_f32,
+                       rcp<RenderBuffer> indices_u16,
+                       uint32_t vertexCount,
+                       uint32_t indexCount,
+                       BlendMode blendMode,
+                       float opacity) override
+    {
+        assert(vertices_f32->sizeInBytes() == vertexCount * sizeof(Vec2D));
+        assert(uvCoords_f32->sizeInBytes() == vertexCount * sizeof(Vec2D));
+        assert(indices_u16->sizeInBytes() == indexCount * sizeof(uint16_t));
+
+        CountFrameStat(&FrameStats::images);
+        CountFrameStat(&FrameStats::meshVertices, vertexCount);
+
+        // The buffers are owned by the artboard and outlive playback.
+        auto uvs = static_cast<RenderBufferSharp*>(uvCoords_f32.get());
+        auto indices = static_cast<RenderBufferSharp*>(indices_u16.get());
+        uvs->markMirrored();
+        indices->markMirrored();
+        m_commands->push(RenderCommandBuffer::DrawImageMeshCommand{
+            Op::drawImageMesh,
+            (int32_t)blendMode,
+            static_cast<const RenderImageSharp*>(image)->m_ref,
+            reinterpret_cast<intptr_t>(
+                static_cast<RenderBufferSharp*>(vertices_f32.get())->f32s()),
+            reinterpret_cast<intptr_t>(uvs->f32s()),
+            reinterpret_cast<intptr_t>(indices->u16s()),
+            (int32_t)vertexCount,
+            (int32_t)indexCount,
+            uvs->id(),
+            uvs->version(),
+            indices->id(),
+            indices->version(),
+            opacity,
+            0});
+    }
+
+private:
+    // Records the path's pending geometry inline. The RawPath is not modified
+    // during draw, so its storage is still valid at playback.
+    void commitPath(RenderPathSharp* path)
+    {
+        if (path->dirty())
+        {
+            const RawPath& rawPath = path->rawPath();
+            CountFrameStat(&FrameStats::pathVerbs, rawPath.verbs().size());
+            m_commands->push(RenderCommandBuffer::CommitPathCommand{
+                Op::commitPath,
+                (int32_t)path->fillRuleValue(),
+                path->m_ref,
+                reinterpret_cast<intptr_t>(rawPath.points().data()),
+                reinterpret_cast<intptr_t>(rawPath.verbs().data()),
+                (int32_t)rawPath.points().size(),
+                (int32_t)rawPath.verbs().size()});
+            path->markCommitted();
+        }
+    }
+
+    RenderCommandBuffer* const m_commands;
+};
+
+// Renderer that draws nothing, and instead records the bounds and a signature
+// of every draw, so two frames can be compared to find the part of the
+// artboard that changed between them. A signature covers everything that
+// affects the draw's pixels: its transform, and the identity and version of
+// its path, paint, image or mesh buffers.
+class DirtyTracker : public Renderer
+{
+public:
+    struct Draw
+    {
+        uint64_t signature;
+        AABB bounds; // Artboard space. minX > maxX if the draw is empty.
+    };
+
+    DirtyTracker(std::vector<Draw>* draws) : m_draws(draws)
+    {
+        m_draws->clear();
+        m_stack.push_back(Mat2D());
+    }
+
+    void save() override { m_stack.push_back(m_stack.back()); }
+    void restore() override
+    {
+        if (m_stack.size() > 1)
+        {
+            m_stack.pop_back();
+        }
+    }
+    void transform(const Mat2D& m) override
+    {
+        m_stack.back() = m_stack.back() * m;
+    }
+    void drawPath(RenderPath* path, RenderPaint* paint) override
+    {
+        auto sharpPath = static_cast<RenderPathSharp*>(path);
+        auto sharpPaint = static_cast<RenderPaintSharp*>(paint);
+        // With the default miter limit of 4, strokes reach at most twice their
+        // thickness past the path.
+        float outset =
+            sharpPaint->isStroke() ? sharpPaint->thicknessValue() * 2 : 0;
+        uint64_t hash = HashValue(Op::drawPath);
+        hash = HashValue(sharpPath, hash);
+        hash = HashValue(sharpPath->version(), hash);
+        hash = HashValue(sharpPaint, hash);
+        hash = HashValue(sharpPaint->version(), hash);
+        record(hash, PointBounds(sharpPath->rawPath().points(), outset));
+    }
+    void clipPath(RenderPath* path) override
+    {
+        auto sharpPath = static_cast<RenderPathSharp*>(path);
+        uint64_t hash = HashValue(Op::clipPath);
+        hash = HashValue(sharpPath, hash);
+        hash = HashValue(sharpPath->version(), hash);
+        record(hash, PointBounds(sharpPath->rawPath().points(), 0));
+    }
+    void drawImage(const RenderImage* image,
+                   BlendMode blendMode,
+                   float opacity) override
+    {
+        uint64_t hash = HashValue(Op::drawImage);
+        hash = HashValue(image, hash);
+        hash = HashValue(blendMode, hash);
+        hash = HashValue(opacity, hash);
+        record(hash,
+               AABB(0, 0, (float)image->width(), (float)image->height()));
+    }
+    void drawImageMesh(const RenderImage* image,
+                       rcp<RenderBuffer> vertices_f32,
+                       rcp<RenderBuffer> uvCoords_f32,
+                       rcp<RenderBuffer> indices_u16,
+                       uint32_t vertexCount,
+                       uint32_t,
+                       BlendMode blendMode,
+                       float opacity) override
+    {
+        uint64_t hash = HashValue(Op::drawImageMesh);
+        hash = HashValue(image, hash);
+        hash = HashValue(blendMode, hash);
+        hash = HashValue(opacity, hash);
+        for (RenderBuffer* buffer :
+             {vertices_f32.get(), uvCoords_f32.get(), indices_u16.get()})
+        {
+            auto sharpBuffer = static_cast<RenderBufferSharp*>(buffer);
+            hash = HashValue(sharpBuffer->id(), hash);
+            hash = HashValue(sharpBuffer->version(), hash);
+        }
+        auto vertices =
+            static_cast<RenderBufferSharp*>(vertices_f32.get())->vecs();
+        record(hash, PointBounds(Span<const Vec2D>(vertices, vertexCount), 0));
+    }
+
+    // Unions into bounds the region covered by draws that differ between the
+    // two frames, or by every draw if all is true. Returns false if nothing
+    // differs.
+    static bool Diff(const std::vector<Draw>& before,
+                     const std::vector<Draw>& after,
+                     bool all,
+                     AABB* bounds)
+    {
+        bool changed = false;
+        size_t n = std::max(before.size(), after.size());
+        for (size_t i = 0; i < n; ++i)
+        {
+            bool hasBefore = i < before.size();
+            bool hasAfter = i < after.size();
+            if (!all && hasBefore && hasAfter &&
+                before[i].signature == after[i].signature)
+            {
+                continue;
+            }
+            if (hasBefore)
+            {
+                Union(before[i].bounds, bounds, &changed);
+            }
+            if (hasAfter)
+            {
+                Union(after[i].bounds, bounds, &changed);
+            }
+        }
+        return changed;
+    }
+
+private:
+    using Op = RenderCommandBuffer::Op;
+
+    template <typename T>
+    static uint64_t HashValue(const T& value,
+                              uint64_t hash = 0xcbf29ce484222325ull)
+    {
+        return HashBytes(&value, sizeof(T), hash);
+    }
+
+    static AABB PointBounds(Span<const Vec2D> points, float outset)
+    {
+        if (points.size() == 0)
+        {
+            return AABB(1, 1, 0, 0);
+        }
+        AABB bounds = kernels::PointBounds(points.data(), points.size());
+        return AABB(bounds.minX - outset,
+                    bounds.minY - outset,
+                    bounds.maxX + outset,
+                    bounds.maxY + outset);
+    }
+
+    static void Union(const AABB& bounds, AABB* total, bool* any)
+    {
+        if (bounds.minX > bounds.maxX)
+        {
+            return;
+        }
+        if (!*any)
+        {
+            *total = bounds;
+            *any = true;
+            return;
+        }
+        total->minX = std::min(total->minX, bounds.minX);
+        total->minY = std::min(total->minY, bounds.minY);
+        total->maxX = std::max(total->maxX, bounds.maxX);
+        total->maxY = std::max(total->maxY, bounds.maxY);
+    }
+
+    // Records a draw with the given local bounds under the current transform.
+    void record(uint64_t hash, const AABB& local)
+    {
+        const Mat2D& m = m_stack.back();
+        const float matrix[6] =
+            {m.xx(), m.xy(), m.yx(), m.yy(), m.tx(), m.ty()};
+        hash = HashBytes(matrix, sizeof(matrix), hash);
+        if (local.minX > local.maxX)
+        {
+            m_draws->push_back({hash, local});
+            return;
+        }
+        const Vec2D corners[4] = {m * Vec2D(local.minX, local.minY),
+                                  m * Vec2D(local.maxX, local.minY),
+                                  m * Vec2D(local.maxX, local.maxY),
+                                  m * Vec2D(local.minX, local.maxY)};
+        m_draws->push_back(
+            {hash, PointBounds(Span<const Vec2D>(corners, 4), 0)});
+    }
+
+    std::vector<Draw>* const m_draws;
+    std::vector<Mat2D> m_stack;
+};
+
+// Must match ComputeAlignmentArgs in Benchmarks/MathValidation.cs.
 struct ComputeAlignmentArgs
 {
     int32_t fit;
@@ -498,6 +1636,90 @@ RIVE_DLL_VOID Renderer_ComputeAlignment(ComputeAlignmentArgs* args)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Process-wide LRU cache of gradient shaders, keyed by geometry and color/stop
+// content. Animations tend to rebuild the same gradients every frame; handing
+// back the existing shader avoids the allocations here, and its stable id lets
+// RenderPaintSharp and the managed SKShader cache skip the rest of the work.
+class GradientCache
+{
+public:
+    using GradientShader = RenderPaintSharp::GradientShader;
+
+    static constexpr size_t kCapacity = 512;
+
+    static GradientCache* Instance()
+    {
+        static GradientCache* instance = new GradientCache();
+        return instance;
+    }
+
+    rcp<RenderShader> get(GradientShader::Type type,
+                          const float geometry[4],
+                          const uint32_t colors[],
+                          const float stops[],
+                          int n)
+    {
+        uint64_t hash = HashBytes(&type, sizeof(type));
+        hash = HashBytes(geometry, sizeof(float) * 4, hash);
+        hash = HashBytes(colors, sizeof(uint32_t) * n, hash);
+        hash = HashBytes(stops, sizeof(float) * n, hash);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto iter = m_entries.find(hash);
+        if (iter != m_entries.end())
+        {
+            Entry& entry = iter->second;
+            m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+            if (entry.shader->equals(type, geometry, colors, stops, n))
+            {
+                return entry.shader;
+            }
+            // Hash collision. The newer gradient replaces the older one.
+            entry.shader = make(type, geometry, colors, stops, n);
+            return entry.shader;
+        }
+
+        if (m_entries.size() >= kCapacity)
+        {
+            m_entries.erase(m_lru.back());
+            m_lru.pop_back();
+        }
+        m_lru.push_front(hash);
+        Entry& entry = m_entries[hash];
+        entry.shader = make(type, geometry, colors, stops, n);
+        entry.lruPosition = m_lru.begin();
+        return entry.shader;
+    }
+
+private:
+    struct Entry
+    {
+        rcp<GradientShader> shader;
+        std::list<uint64_t>::iterator lruPosition;
+    };
+
+    rcp<GradientShader> make(GradientShader::Type type,
+                             const float geometry[4],
+                             const uint32_t colors[],
+                             const float stops[],
+                             int n)
+    {
+        return make_rcp<GradientShader>(type,
+                                        geometry,
+                                        colors,
+                                        stops,
+                                        n,
+                                        ++m_lastID);
+    }
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::list<uint64_t> m_lru; // Most recently used first.
+    uint32_t m_lastID = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 class FactorySharp : public Factory
 {
 public:
@@ -520,15 +1742,23 @@ public:
     };
 
     static Delegates s_delegates;
+    static const Delegates& callbacks(ManagedDelegate delegate)
+    {
+        CountManagedCall(delegate);
+        return s_delegates;
+    }
 
     FactorySharp(intptr_t managedRef) : m_ref(managedRef) {}
-    ~FactorySharp() { s_delegates.release(m_ref); }
+    ~FactorySharp()
+    {
+        callbacks(ManagedDelegate::factoryRelease).release(m_ref);
+    }
 
     rcp<RenderBuffer> makeRenderBuffer(RenderBufferType type,
                                        RenderBufferFlags flags,
                                        size_t sizeInBytes) override
     {
-        return make_rcp<DataRenderBuffer>(type, flags, sizeInBytes);
+        return make_rcp<RenderBufferSharp>(type, flags, sizeInBytes);
     }
 
     rcp<RenderShader> makeLinearGradient(float sx,
@@ -539,14 +1769,14 @@ public:
                                          const float stops[],     // [count]
                                          size_t count) override
     {
-        return rcp<RenderShader>(
-            new RenderPaintSharp::LinearGradientShader(sx,
-                                                       sy,
-                                                       ex,
-                                                       ey,
-                                                       colors,
-                                                       stops,
-                                                       (int)count));
+        CountFrameStat(&FrameStats::gradients);
+        const float geometry[4] = {sx, sy, ex, ey};
+        return GradientCache::Instance()->get(
+            RenderPaintSharp::GradientShader::Type::linear,
+            geometry,
+            colors,
+            stops,
+            (int)count);
     }
 
     rcp<RenderShader> makeRadialGradient(float cx,
@@ -556,175 +1786,1338 @@ public:
                                          const float stops[],     // [count]
                                          size_t count) override
     {
-        return rcp<RenderShader>(
-            new RenderPaintSharp::RadialGradientShader(cx,
-                                                       cy,
-                                                       radius,
-                                                       colors,
-                                                       stops,
-                                                       (int)count));
+        CountFrameStat(&FrameStats::gradients);
+        const float geometry[4] = {cx, cy, radius, 0};
+        return GradientCache::Instance()->get(
+            RenderPaintSharp::GradientShader::Type::radial,
+            geometry,
+            colors,
+            stops,
+            (int)count);
+    }
+
+    rcp<RenderPath> makeRenderPath(RawPath& rawPath, FillRule fillRule) override
+    {
+        CountFrameStat(&FrameStats::pathVerbs, rawPath.verbs().size());
+        return make_rcp<RenderPathSharp>(
+            callbacks(ManagedDelegate::factoryMakeRenderPath).makeRenderPath(
+                m_ref,
+                reinterpret_cast<intptr_t>(rawPath.points().data()),
+                rawPath.points().size(),
+                reinterpret_cast<intptr_t>(rawPath.verbs().data()),
+                rawPath.verbs().size(),
+                (int)fillRule),
+            rawPath,
+            fillRule);
+    }
+
+    rcp<RenderPath> makeEmptyRenderPath() override
+    {
+        return make_rcp<RenderPathSharp>(
+            callbacks(ManagedDelegate::factoryMakeEmptyRenderPath)
+                .makeEmptyRenderPath(m_ref));
+    }
+
+    rcp<RenderPaint> makeRenderPaint() override
+    {
+        return make_rcp<RenderPaintSharp>(
+            callbacks(ManagedDelegate::factoryMakeRenderPaint)
+                .makeRenderPaint(m_ref));
+    }
+
+    // Returns as soon as the managed side has read the image header, so import
+    // doesn't wait on pixels. Those decode concurrently on the thread pool.
+    rcp<RenderImage> decodeImage(Span<const uint8_t> bytes) override
+    {
+        intptr_t managedRef =
+            callbacks(ManagedDelegate::factoryDecodeImage)
+                .decodeImage(m_ref,
+                             reinterpret_cast<intptr_t>(bytes.data()),
+                             bytes.count());
+        return managedRef ? make_rcp<RenderImageSharp>(managedRef) : nullptr;
+    }
+
+    const intptr_t m_ref;
+};
+
+FactorySharp::Delegates FactorySharp::s_delegates{};
+
+RIVE_DLL_VOID Factory_RegisterDelegates(FactorySharp::Delegates delegates)
+{
+    FactorySharp::s_delegates = delegates;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Fixed-size pool of worker threads shared by the whole library. WASM builds
+// have no threads, so tasks run inline on the calling thread.
+class WorkerPool
+{
+public:
+    // Intentionally leaked so we never have to join threads during DLL unload.
+    static WorkerPool* Shared()
+    {
+        static WorkerPool* pool = new WorkerPool();
+        return pool;
+    }
+
+    size_t threadCount() const { return m_threadCount; }
+
+    void submit(std::function<void()> task)
+    {
+        if (m_threadCount == 0)
+        {
+            task();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_cond.notify_one();
+    }
+
+    // Calls fn(i) for every i in [0, count) across the pool and the calling
+    // thread, and blocks until all calls have returned. Indices are handed out
+    // one at a time from a shared cursor, so whichever thread finishes first
+    // picks up the next item and uneven workloads still balance out.
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+private:
+    WorkerPool()
+    {
+#ifndef WASM
+        // The thread calling parallelFor() does work too.
+        unsigned int n = std::thread::hardware_concurrency();
+        for (unsigned int i = 1; i < n; ++i)
+        {
+            std::thread([this]() { workerLoop(); }).detach();
+            ++m_threadCount;
+        }
+#endif
+    }
+
+    void workerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cond.wait(lock, [this]() { return !m_tasks.empty(); });
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    size_t m_threadCount = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<std::function<void()>> m_tasks;
+};
+
+// Tracks tasks submitted to a WorkerPool so they can be waited on as a group.
+class TaskGroup
+{
+public:
+    TaskGroup(WorkerPool* pool) : m_pool(pool) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    ~TaskGroup() { wait(); }
+
+    void run(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_pending;
+        }
+        m_pool->submit([this, task = std::move(task)]() {
+            task();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0)
+            {
+                m_cond.notify_all();
+            }
+        });
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]() { return m_pending == 0; });
+    }
+
+private:
+    WorkerPool* const m_pool;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    size_t m_pending = 0;
+};
+
+void WorkerPool::parallelFor(size_t count,
+                             const std::function<void(size_t)>& fn)
+{
+    std::atomic<size_t> cursor{0};
+    auto drain = [&]() {
+        for (size_t i; (i = cursor.fetch_add(1)) < count;)
+        {
+            fn(i);
+        }
+    };
+    TaskGroup group(this);
+    size_t helpers = std::min(threadCount(), count > 0 ? count - 1 : 0);
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        group.run(drain);
+    }
+    drain();
+    group.wait();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A parsed .riv file that can be shared by any number of NativeScenes.
+// Files are cached by content, so importing the same bytes twice returns the
+// same File (along with its decoded images and paths) instead of parsing it
+// again.
+class NativeFile : public RefCnt<NativeFile>
+{
+public:
+    // Returns the cached file with identical contents, or imports a new one.
+    // Returns null if the bytes are not a valid .riv file.
+    static rcp<NativeFile> Load(const uint8_t* bytes,
+                                size_t length,
+                                std::shared_ptr<Factory> factory)
+    {
+        const Factory* backend = factory.get();
+        Key key{DigestBytes(bytes, length), length, &typeid(*backend)};
+        std::unique_lock<std::mutex> lock(s_cacheMutex);
+        for (;;)
+        {
+            auto iter = s_cache.find(key);
+            if (iter != s_cache.end())
+            {
+                if (iter->second->sameContents(bytes, length))
+                {
+                    return iter->second;
+                }
+                // A digest collision. Import a private, uncached copy.
+                lock.unlock();
+                return Import(key, bytes, length, std::move(factory));
+            }
+            auto importing = s_importing.find(key);
+            if (importing == s_importing.end())
+            {
+                break;
+            }
+            // Another thread is importing the same key. Wait for it without
+            // holding the lock, then look again. (If its import failed or
+            // collided, the key still isn't cached and we import it here.)
+            std::shared_future<void> imported = importing->second;
+            lock.unlock();
+            imported.wait();
+            lock.lock();
+        }
+
+        // Import without holding the lock, so imports of other files (and
+        // their decodeImage calls into managed code) don't wait on this one.
+        std::promise<void> done;
+        s_importing[key] = done.get_future().share();
+        lock.unlock();
+        rcp<NativeFile> nativeFile =
+            Import(key, bytes, length, std::move(factory));
+        lock.lock();
+        s_importing.erase(key);
+        if (nativeFile)
+        {
+            s_cache[key] = nativeFile;
+        }
+        lock.unlock();
+        done.set_value();
+        return nativeFile;
+    }
+
+    // Drops a reference to the file, and evicts it from the cache if the cache
+    // was the only other owner. (New references can only be handed out by the
+    // cache while holding s_cacheMutex, so a refcount of 1 can't race.)
+    static void Release(rcp<NativeFile> file)
+    {
+        if (!file)
+        {
+            return;
+        }
+        Key key = file->m_key;
+        const NativeFile* released = file.get();
+        file.reset();
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        auto iter = s_cache.find(key);
+        if (iter != s_cache.end() && iter->second.get() == released &&
+            iter->second->debugging_refcnt() == 1)
+        {
+            s_cache.erase(iter);
+        }
+    }
+
+    const File* file() const { return m_file.get(); }
+
+    // Files can only be drawn by scenes whose factory is the same kind of
+    // backend as the one that imported them.
+    bool compatibleWith(const Factory* factory) const
+    {
+        return *m_key.backend == typeid(*factory);
+    }
+
+private:
+    struct Key
+    {
+        ContentDigest digest;
+        size_t length;
+        // Each backend imports its own copy of the file.
+        const std::type_info* backend;
+        bool operator==(const Key& other) const
+        {
+            return digest == other.digest && length == other.length &&
+                   *backend == *other.backend;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return (size_t)(key.digest.h1 ^ key.length) ^
+                   key.backend->hash_code();
+        }
+    };
+
+    static rcp<NativeFile> Import(Key key,
+                                  const uint8_t* bytes,
+                                  size_t length,
+                                  std::shared_ptr<Factory> factory)
+    {
+        auto software = dynamic_cast<SoftwareFactory*>(factory.get());
+        uint32_t undecodedBefore =
+            software ? software->undecodedImageCount() : 0;
+        std::unique_ptr<File> file =
+            File::import(Span<const uint8_t>(bytes, length), factory.get());
+        // The software backend has no image decoder, and a file missing its
+        // images would draw wrong frames. Refuse it instead.
+        bool missingImages =
+            software && software->undecodedImageCount() != undecodedBefore;
+        if (!file || missingImages)
+        {
+            return nullptr;
+        }
+        return rcp<NativeFile>(new NativeFile(key,
+                                              bytes,
+                                              length,
+                                              std::move(factory),
+                                              std::move(file)));
+    }
+
+    NativeFile(Key key,
+               const uint8_t* bytes,
+               size_t length,
+               std::shared_ptr<Factory> factory,
+               std::unique_ptr<File> file) :
+        m_key(key),
+        m_samples(Samples(bytes, length)),
+        m_factory(std::move(factory)),
+        m_file(std::move(file))
+    {}
+
+    // The start, middle, and end of the file. The digest already identifies
+    // the contents; these are a cheap extra check that a hit is really the
+    // same file, without keeping (or copying) all of it.
+    static constexpr size_t kSampleLength = 64;
+
+    static std::vector<uint8_t> Samples(const uint8_t* bytes, size_t length)
+    {
+        if (length <= kSampleLength * 3)
+        {
+            return std::vector<uint8_t>(bytes, bytes + length);
+        }
+        std::vector<uint8_t> samples(bytes, bytes + kSampleLength);
+        const uint8_t* middle = bytes + (length - kSampleLength) / 2;
+        samples.insert(samples.end(), middle, middle + kSampleLength);
+        const uint8_t* end = bytes + length;
+        samples.insert(samples.end(), end - kSampleLength, end);
+        return samples;
+    }
+
+    bool sameContents(const uint8_t* bytes, size_t length) const
+    {
+        return m_key.length == length && Samples(bytes, length) == m_samples;
+    }
+
+    const Key m_key;
+    const std::vector<uint8_t> m_samples;
+    // The File and every artboard instanced from it reference the factory.
+    const std::shared_ptr<Factory> m_factory;
+    const std::unique_ptr<File> m_file;
+
+    static std::mutex s_cacheMutex;
+    static std::unordered_map<Key, rcp<NativeFile>, KeyHash> s_cache;
+    // Keys being imported, and a future that's ready when each one is done.
+    static std::unordered_map<Key, std::shared_future<void>, KeyHash>
+        s_importing;
+};
+
+std::mutex NativeFile::s_cacheMutex;
+std::unordered_map<NativeFile::Key, rcp<NativeFile>, NativeFile::KeyHash>
+    NativeFile::s_cache;
+std::unordered_map<NativeFile::Key,
+                   std::shared_future<void>,
+                   NativeFile::KeyHash>
+    NativeFile::s_importing;
+
+RIVE_DLL_INTPTR RiveFile_Load(intptr_t managedFactory,
+                              const uint8_t* fileBytes,
+                              int length)
+{
+    rcp<NativeFile> file =
+        NativeFile::Load(fileBytes,
+                         length,
+                         std::make_shared<FactorySharp>(managedFactory));
+    return reinterpret_cast<intptr_t>(file.release());
+}
+
+RIVE_DLL_INTPTR RiveFile_LoadSoftware(const uint8_t* fileBytes, int length)
+{
+    rcp<NativeFile> file =
+        NativeFile::Load(fileBytes,
+                         length,
+                         std::make_shared<SoftwareFactory>());
+    return reinterpret_cast<intptr_t>(file.release());
+}
+
+RIVE_DLL_VOID RiveFile_Release(intptr_t ref)
+{
+    NativeFile::Release(rcp<NativeFile>(reinterpret_cast<NativeFile*>(ref)));
+    ManagedRefReleaser::Flush();
+}
+
+// Must match RenderSequenceArgs in RiveAPI.cs.
+struct RenderSequenceArgs
+{
+    // The scene is advanced by startSeconds before the first frame, and by
+    // 1/fps before each one after that.
+    float startSeconds;
+    float fps;
+    int32_t frameCount;
+    int32_t width;
+    int32_t height;
+    int32_t rowBytes;
+    Mat2D transform;
+    // Every frame is cleared to this (unpremultiplied ARGB) before drawing.
+    uint32_t clearColor;
+    // Frame i is drawn into surfaces[i % surfaceCount].
+    int32_t surfaceCount;
+    uint8_t* const* surfaces;
+    // Passed to frameReady once each frame is complete, or 0 for no callbacks.
+    intptr_t frameSink;
+};
+
+// Must match PointerEventType in Scene.cs.
+enum class PointerEventType : int32_t
+{
+    down,
+    move,
+    up,
+};
+
+// Pointer events queued by a UI thread, in view coordinates, for the thread
+// that advances the scene to dispatch all at once. Consecutive moves coalesce
+// into the latest one, since the state machine only needs to know where the
+// pointer ended up between downs and ups. The view-to-artboard transform is
+// cached here too, so queueing an event doesn't need to compute an alignment.
+class PointerQueue
+{
+public:
+    void setTransform(const Mat2D& viewToArtboard)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_transform = viewToArtboard;
+    }
+
+    void push(PointerEventType type, Vec2D viewPosition)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (type == PointerEventType::move && m_count > 0)
+        {
+            Event& last = m_events[(m_head + m_count - 1) % kCapacity];
+            if (last.type == PointerEventType::move)
+            {
+                last.viewPosition = viewPosition;
+                return;
+            }
+        }
+        if (m_count == kCapacity)
+        {
+            // Only reachable with kCapacity downs and ups inside a single
+            // frame. Drop the oldest.
+            m_head = (m_head + 1) % kCapacity;
+            --m_count;
+        }
+        m_events[(m_head + m_count) % kCapacity] = {type, viewPosition};
+        ++m_count;
+    }
+
+    // Empties the queue into the scene, if there is one.
+    void dispatch(Scene* scene)
+    {
+        Event events[kCapacity];
+        size_t count;
+        Mat2D transform;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            count = m_count;
+            for (size_t i = 0; i < count; ++i)
+            {
+                events[i] = m_events[(m_head + i) % kCapacity];
+            }
+            m_head = m_count = 0;
+            transform = m_transform;
+        }
+        for (size_t i = 0; scene && i < count; ++i)
+        {
+            Vec2D position = transform * events[i].viewPosition;
+            switch (events[i].type)
+            {
+                case PointerEventType::down:
+                    scene->pointerDown(position);
+                    break;
+                case PointerEventType::move:
+                    scene->pointerMove(position);
+                    break;
+                case PointerEventType::up:
+                    scene->pointerUp(position);
+                    break;
+            }
+        }
+    }
+
+private:
+    struct Event
+    {
+        PointerEventType type;
+        Vec2D viewPosition;
+    };
+
+    static constexpr size_t kCapacity = 64;
+
+    std::mutex m_mutex;
+    Event m_events[kCapacity];
+    size_t m_head = 0;
+    size_t m_count = 0;
+    Mat2D m_transform;
+};
+
+class NativeScene
+{
+public:
+    struct Delegates
+    {
+        // Returns 0 to stop rendering the sequence.
+        RIVE_DELEGATE_INT32(frameReady,
+                            intptr_t sink,
+                            int32_t frame,
+                            int32_t surface);
+    };
+
+    static Delegates s_delegates;
+    static const Delegates& callbacks(ManagedDelegate delegate)
+    {
+        CountManagedCall(delegate);
+        return s_delegates;
+    }
+
+    NativeScene(std::shared_ptr<Factory> factory) :
+        m_Factory(std::move(factory)),
+        m_IsSoftware(dynamic_cast<SoftwareFactory*>(m_Factory.get()) !=
+                     nullptr)
+    {}
+
+    ~NativeScene() { unloadFile(); }
+
+    bool loadFile(const uint8_t* fileBytes, int length)
+    {
+        unloadFile();
+        m_File = NativeFile::Load(fileBytes, length, m_Factory);
+        return m_File != nullptr;
+    }
+
+    bool loadFile(rcp<NativeFile> file)
+    {
+        unloadFile();
+        if (file && !file->compatibleWith(m_Factory.get()))
+        {
+            NativeFile::Release(std::move(file));
+        }
+        m_File = std::move(file);
+        return m_File != nullptr;
+    }
+
+    bool loadArtboard(const char* name)
+    {
+        m_Scene.reset();
+        m_PreviousDrawsStale = true;
+        if (m_File)
+        {
+            m_Artboard = InstanceArtboard(m_File->file(), name);
+        }
+        return m_Artboard != nullptr;
+    }
+
+    bool loadStateMachine(const char* name)
+    {
+        if (m_Artboard)
+        {
+            m_Scene = InstanceStateMachine(m_Artboard.get(), name);
+        }
+        return m_Scene != nullptr;
+    }
+
+    bool loadAnimation(const char* name)
+    {
+        if (m_Artboard)
+        {
+            m_Scene = InstanceAnimation(m_Artboard.get(), name);
+        }
+        return m_Scene != nullptr;
+    }
+
+    bool setBool(const char* name, bool value)
+    {
+        if (SMIBool * input; m_Scene && (input = m_Scene->getBool(name)))
+        {
+            input->value(value);
+            return true;
+        }
+        return false;
+    }
+
+    bool setNumber(const char* name, float value)
+    {
+        if (SMINumber * input; m_Scene && (input = m_Scene->getNumber(name)))
+        {
+            input->value(value);
+            return true;
+        }
+        return false;
+    }
+
+    bool fireTrigger(const char* name)
+    {
+        if (SMITrigger * input; m_Scene && (input = m_Scene->getTrigger(name)))
+        {
+            input->fire();
+            return true;
+        }
+        return false;
+    }
+
+    // Resolves an input name to a handle that can be used with the "At"
+    // setters below. Handles are the input's index in the state machine, and
+    // remain valid until a different state machine or animation is loaded.
+    // Returns -1 if there is no input with the given name.
+    int32_t inputHandle(const char* name)
+    {
+        if (m_Scene && name)
+        {
+            for (size_t i = 0, count = m_Scene->inputCount(); i < count; ++i)
+            {
+                if (m_Scene->input(i)->name() == name)
+                {
+                    return (int32_t)i;
+                }
+            }
+        }
+        return -1;
+    }
+
+    template <typename T> T* inputAt(int32_t handle)
+    {
+        if (m_Scene && handle >= 0 && (size_t)handle < m_Scene->inputCount())
+        {
+            return dynamic_cast<T*>(m_Scene->input(handle));
+        }
+        return nullptr;
     }
 
-    rcp<RenderPath> makeRenderPath(RawPath& rawPath, FillRule fillRule) override
+    bool setBoolAt(int32_t handle, bool value)
     {
-        return make_rcp<RenderPathSharp>(s_delegates.makeRenderPath(
-            m_ref,
-            reinterpret_cast<intptr_t>(rawPath.points().data()),
-            rawPath.points().size(),
-            reinterpret_cast<intptr_t>(rawPath.verbs().data()),
-            rawPath.verbs().size(),
-            (int)fillRule));
+        if (SMIBool* input = inputAt<SMIBool>(handle))
+        {
+            input->value(value);
+            return true;
+        }
+        return false;
     }
 
-    rcp<RenderPath> makeEmptyRenderPath() override
+    bool setNumberAt(int32_t handle, float value)
     {
-        return make_rcp<RenderPathSharp>(
-            s_delegates.makeEmptyRenderPath(m_ref));
+        if (SMINumber* input = inputAt<SMINumber>(handle))
+        {
+            input->value(value);
+            return true;
+        }
+        return false;
     }
 
-    rcp<RenderPaint> makeRenderPaint() override
+    bool fireTriggerAt(int32_t handle)
     {
-        return make_rcp<RenderPaintSharp>(s_delegates.makeRenderPaint(m_ref));
+        if (SMITrigger* input = inputAt<SMITrigger>(handle))
+        {
+            input->fire();
+            return true;
+        }
+        return false;
     }
 
-    rcp<RenderImage> decodeImage(Span<const uint8_t> bytes) override
+    // Must match StateMachineInputValue in Scene.cs.
+    struct InputValue
     {
-        intptr_t managedRef =
-            s_delegates.decodeImage(m_ref,
-                                    reinterpret_cast<intptr_t>(bytes.data()),
-                                    bytes.count());
-        return managedRef ? make_rcp<RenderImageSharp>(managedRef) : nullptr;
+        int32_t handle;
+        // Bools are set to (value != 0). Triggers fire if value != 0.
+        float value;
+    };
+
+    // Applies an array of input values. Returns the number that were applied.
+    int32_t setInputs(const InputValue* values, int32_t count)
+    {
+        int32_t applied = 0;
+        for (int32_t i = 0; i < count; ++i)
+        {
+            const InputValue& v = values[i];
+            if (SMIInput* input = inputAt<SMIInput>(v.handle))
+            {
+                if (auto number = dynamic_cast<SMINumber*>(input))
+                {
+                    number->value(v.value);
+                }
+                else if (auto boolean = dynamic_cast<SMIBool*>(input))
+                {
+                    boolean->value(v.value != 0);
+                }
+                else if (auto trigger = dynamic_cast<SMITrigger*>(input))
+                {
+                    if (v.value != 0)
+                    {
+                        trigger->fire();
+                    }
+                }
+                ++applied;
+            }
+        }
+        return applied;
     }
 
-    const intptr_t m_ref;
-};
+    Scene* scene() { return m_Scene.get(); }
 
-FactorySharp::Delegates FactorySharp::s_delegates{};
+    // Every advance begins a new frame of stats.
+    bool advanceAndApply(float elapsedSeconds)
+    {
+        if (!m_Scene)
+        {
+            return false;
+        }
+        m_TotalStats += m_FrameStats;
+        m_FrameStats = {};
+        ++m_FrameCount;
+        FrameStatsScope scope(&m_FrameStats, &FrameStats::advanceNanoseconds);
+        m_PointerQueue.dispatch(m_Scene.get());
+        return m_Scene->advanceAndApply(elapsedSeconds);
+    }
 
-RIVE_DLL_VOID Factory_RegisterDelegates(FactorySharp::Delegates delegates)
-{
-    FactorySharp::s_delegates = delegates;
-}
+    PointerQueue* pointerQueue() { return &m_PointerQueue; }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Evaluates a linear animation directly at the given number of seconds
+    // from its start, clamped to its duration, instead of stepping there with
+    // deltas. Each keyed property finds its keyframe pair with a binary
+    // search, so the cost doesn't depend on how far into the timeline the
+    // seek lands. Returns false if the scene isn't a linear animation.
+    bool seekTo(float seconds)
+    {
+        auto animation = dynamic_cast<LinearAnimationInstance*>(m_Scene.get());
+        if (!animation)
+        {
+            return false;
+        }
+        const LinearAnimation* source = animation->animation();
+        seconds = std::min(std::max(seconds, 0.f), source->durationSeconds());
+        animation->time(source->startSeconds() + seconds);
+        animation->advanceAndApply(0);
+        return true;
+    }
 
-class NativeScene
-{
-public:
-    NativeScene(std::unique_ptr<FactorySharp> factory) :
-        m_Factory(std::move(factory))
-    {}
+    // Calls into the managed renderer once for every individual render
+    // command.
+    void drawImmediate(intptr_t renderer)
+    {
+        if (m_Scene && !m_IsSoftware)
+        {
+            FrameStatsScope scope(&m_FrameStats, &FrameStats::drawNanoseconds);
+            RendererSharp nativeRenderer(renderer);
+            m_Scene->draw(&nativeRenderer);
+        }
+    }
 
-    bool loadFile(const uint8_t* fileBytes, int length)
+    // Records the frame into m_Commands and replays it in managed code with a
+    // single reverse P/Invoke.
+    void drawBatched(intptr_t renderer)
     {
-        m_Scene.reset();
-        m_Artboard.reset();
-        m_File = File::import(Span<const uint8_t>(fileBytes, length),
-                              m_Factory.get());
-        return m_File != nullptr;
+        if (m_Scene && !m_IsSoftware)
+        {
+            FrameStatsScope scope(&m_FrameStats, &FrameStats::drawNanoseconds);
+            m_Commands.reset();
+            RecordingRenderer recorder(&m_Commands);
+            m_Scene->draw(&recorder);
+            m_Commands.playback(renderer);
+        }
     }
 
-    bool loadArtboard(const char* name)
+    // Finds the region of the artboard whose pixels may have changed since the
+    // previous call, by diffing a DirtyTracker pass against the one before.
+    // Returns false if nothing changed. Hosts should outset the bounds by a
+    // pixel, after mapping them to the screen, to cover antialiasing. Software
+    // scenes aren't tracked, and always report their whole bounds.
+    bool dirtyBounds(AABB* bounds)
     {
-        m_Scene.reset();
-        if (m_File)
+        if (m_IsSoftware)
         {
-            m_Artboard = (name && name[0]) ? m_File->artboardNamed(name)
-                                           : m_File->artboardDefault();
+            if (!m_Scene)
+            {
+                return false;
+            }
+            *bounds = m_Scene->bounds();
+            return true;
         }
-        return m_Artboard != nullptr;
+        DirtyTracker tracker(&m_Draws);
+        if (m_Scene)
+        {
+            m_Scene->draw(&tracker);
+        }
+        bool changed = DirtyTracker::Diff(m_PreviousDraws,
+                                          m_Draws,
+                                          m_PreviousDrawsStale,
+                                          bounds);
+        m_PreviousDraws.swap(m_Draws);
+        m_PreviousDrawsStale = false;
+        return changed;
     }
 
-    bool loadStateMachine(const char* name)
+    // Records the scene, aligned into frame, onto a shared recorder. Used by
+    // Scene_DrawAtlas to batch many scenes into a single playback.
+    void recordAligned(RecordingRenderer* recorder,
+                       Fit fit,
+                       Alignment alignment,
+                       const AABB& frame)
     {
-        if (m_Artboard)
+        if (m_Scene && !m_IsSoftware)
         {
-            m_Scene = (name && name[0]) ? m_Artboard->stateMachineNamed(name)
-                                        : m_Artboard->stateMachineAt(0);
+            FrameStatsScope scope(&m_FrameStats, &FrameStats::drawNanoseconds);
+            recorder->save();
+            recorder->transform(computeAlignment(
+                fit,
+                alignment,
+                frame,
+                AABB(0, 0, m_Scene->width(), m_Scene->height())));
+            m_Scene->draw(recorder);
+            recorder->restore();
         }
-        return m_Scene != nullptr;
     }
 
-    bool loadAnimation(const char* name)
+    // Scenes created with a SoftwareFactory draw into native pixel buffers
+    // instead of managed Renderers.
+    bool isSoftware() const { return m_IsSoftware; }
+
+    // Composites the scene into premultiplied RGBA8888 pixels, after applying
+    // the given transform.
+    bool drawSoftware(uint8_t* pixels,
+                      int32_t width,
+                      int32_t height,
+                      int32_t rowBytes,
+                      const Mat2D& transform)
     {
-        if (m_Artboard)
+        if (!m_Scene || !m_IsSoftware || !pixels || width <= 0 ||
+            height <= 0 || rowBytes < width * 4)
         {
-            m_Scene = (name && name[0]) ? m_Artboard->animationNamed(name)
-                                        : m_Artboard->animationAt(0);
+            return false;
         }
-        return m_Scene != nullptr;
+        FrameStatsScope scope(&m_FrameStats, &FrameStats::drawNanoseconds);
+        SoftwareRenderer renderer(pixels, width, height, rowBytes);
+        renderer.transform(transform);
+        m_Scene->draw(&renderer);
+        return true;
     }
 
-    bool setBool(const char* name, bool value)
+    // Advances and draws a whole timeline into a ring of surfaces with the
+    // software backend. When there are worker threads and more than one
+    // surface, frames are rendered ahead on the WorkerPool while frameReady
+    // runs on the calling thread, so the consumer (an encoder, typically)
+    // overlaps with rasterization. A surface isn't reused until frameReady
+    // has returned for the frame it holds. Returns the number of frames
+    // rendered, or delivered if there is a frameSink.
+    int32_t renderSequence(const RenderSequenceArgs& args)
     {
-        if (SMIBool * input; m_Scene && (input = m_Scene->getBool(name)))
+        if (!m_Scene || !m_IsSoftware || args.frameCount <= 0 ||
+            args.surfaceCount <= 0 || !args.surfaces || !(args.fps > 0))
         {
-            input->value(value);
-            return true;
+            return 0;
         }
-        return false;
+        auto renderFrame = [this, &args](int32_t frame) {
+            advanceAndApply(frame == 0 ? args.startSeconds : 1 / args.fps);
+            uint8_t* pixels = args.surfaces[frame % args.surfaceCount];
+            ClearPixels(pixels,
+                        args.width,
+                        args.height,
+                        args.rowBytes,
+                        args.clearColor);
+            drawSoftware(pixels,
+                         args.width,
+                         args.height,
+                         args.rowBytes,
+                         args.transform);
+        };
+
+        WorkerPool* pool = WorkerPool::Shared();
+        if (!args.frameSink || args.surfaceCount == 1 ||
+            pool->threadCount() == 0)
+        {
+            for (int32_t frame = 0; frame < args.frameCount; ++frame)
+            {
+                renderFrame(frame);
+                if (args.frameSink &&
+                    !callbacks(ManagedDelegate::sceneFrameReady)
+                         .frameReady(args.frameSink,
+                                     frame,
+                                     frame % args.surfaceCount))
+                {
+                    return frame + 1;
+                }
+            }
+            return args.frameCount;
+        }
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        int32_t rendered = 0;
+        int32_t delivered = 0;
+        bool cancelled = false;
+        TaskGroup producer(pool);
+        producer.run([&]() {
+            for (int32_t frame = 0; frame < args.frameCount; ++frame)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond.wait(lock, [&]() {
+                        return cancelled ||
+                               frame - delivered < args.surfaceCount;
+                    });
+                    if (cancelled)
+                    {
+                        return;
+                    }
+                }
+                renderFrame(frame);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++rendered;
+                }
+                cond.notify_all();
+            }
+        });
+        for (int32_t frame = 0; frame < args.frameCount; ++frame)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&]() { return rendered > frame; });
+            }
+            bool keepGoing =
+                callbacks(ManagedDelegate::sceneFrameReady)
+                    .frameReady(args.frameSink,
+                                frame,
+                                frame % args.surfaceCount);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                delivered = frame + 1;
+                cancelled = !keepGoing;
+            }
+            cond.notify_all();
+            if (!keepGoing)
+            {
+                break;
+            }
+        }
+        producer.wait();
+        return delivered;
     }
 
-    bool setNumber(const char* name, float value)
+    // Writes a snapshot of the loaded artboard and scene into buffer, if it
+    // has room, and returns the snapshot's size in bytes (0 if nothing is
+    // loaded). For a linear animation it records the time and direction; for a
+    // state machine, the value of every input. Snapshots refer to artboards
+    // and scenes by name, so they can be restored into any NativeScene that
+    // has loaded the same file, but only within the same process.
+    int32_t snapshot(uint8_t* buffer, int32_t capacity) const
     {
-        if (SMINumber * input; m_Scene && (input = m_Scene->getNumber(name)))
+        if (!m_Scene)
         {
-            input->value(value);
-            return true;
+            return 0;
         }
-        return false;
+        const std::string& artboardName = m_Artboard->name();
+        std::string sceneName = m_Scene->name();
+        SnapshotHeader header = {};
+        header.magic = kSnapshotMagic;
+        header.artboardNameLength = artboardName.size();
+        header.sceneNameLength = sceneName.size();
+        auto animation =
+            dynamic_cast<const LinearAnimationInstance*>(m_Scene.get());
+        if (animation)
+        {
+            header.kind = SnapshotKind::animation;
+            header.time = animation->time();
+            header.direction = animation->direction();
+        }
+        else
+        {
+            header.kind = SnapshotKind::stateMachine;
+            header.inputCount = m_Scene->inputCount();
+        }
+        uint64_t size = SnapshotSize(header);
+        if (size > (uint64_t)std::numeric_limits<int32_t>::max())
+        {
+            return 0;
+        }
+        if (buffer && size <= (uint64_t)capacity)
+        {
+            uint8_t* p = buffer;
+            memcpy(p, &header, sizeof(header));
+            p += sizeof(header);
+            memcpy(p, artboardName.data(), artboardName.size());
+            p += artboardName.size();
+            memcpy(p, sceneName.data(), sceneName.size());
+            p += sceneName.size();
+            for (uint32_t i = 0; i < header.inputCount; ++i, p += sizeof(float))
+            {
+                // Triggers are transient, so they're never captured as fired.
+                float value = 0;
+                SMIInput* input = m_Scene->input(i);
+                if (auto number = dynamic_cast<SMINumber*>(input))
+                {
+                    value = number->value();
+                }
+                else if (auto boolean = dynamic_cast<SMIBool*>(input))
+                {
+                    value = boolean->value() ? 1 : 0;
+                }
+                memcpy(p, &value, sizeof(float));
+            }
+        }
+        return (int32_t)size;
     }
 
-    bool fireTrigger(const char* name)
+    // Puts this scene in the state captured by snapshot(), and applies it so
+    // it's ready to draw. Restoring into the linear animation that's already
+    // loaded (scrubbing or rewinding) keeps the current artboard instance,
+    // since applying the animation overwrites every property it keys.
+    //
+    // The runtime doesn't expose a state machine's layer states, so those are
+    // never resumed. Instead, a state machine snapshot always restores into a
+    // fresh artboard instance and state machine, at their entry states with
+    // the snapshot's input values, so the result doesn't depend on what this
+    // scene was doing beforehand.
+    //
+    // Nothing changes unless the whole snapshot can be restored: the new
+    // instances are built aside and only swapped in once they're complete.
+    bool restore(const uint8_t* data, int32_t length)
     {
-        if (SMITrigger * input; m_Scene && (input = m_Scene->getTrigger(name)))
+        SnapshotHeader header;
+        if (!data || length < (int32_t)sizeof(header))
         {
-            input->fire();
-            return true;
+            return false;
         }
-        return false;
+        memcpy(&header, data, sizeof(header));
+        // The blob may come from anywhere, so the lengths in it are only
+        // trusted once they add up, without wrapping, to exactly its size.
+        if (header.magic != kSnapshotMagic ||
+            SnapshotSize(header) != (uint64_t)length)
+        {
+            return false;
+        }
+        const char* chars =
+            reinterpret_cast<const char*>(data + sizeof(header));
+        std::string artboardName(chars, header.artboardNameLength);
+        std::string sceneName(chars + header.artboardNameLength,
+                              header.sceneNameLength);
+        const uint8_t* inputValues = data + sizeof(header) +
+                                     header.artboardNameLength +
+                                     header.sceneNameLength;
+
+        if (header.kind == SnapshotKind::animation)
+        {
+            auto animation =
+                dynamic_cast<LinearAnimationInstance*>(m_Scene.get());
+            if (!animation || m_Artboard->name() != artboardName ||
+                animation->name() != sceneName)
+            {
+                if (!m_File)
+                {
+                    return false;
+                }
+                auto artboard =
+                    InstanceArtboard(m_File->file(), artboardName.c_str());
+                auto newAnimation =
+                    artboard ? InstanceAnimation(artboard.get(),
+                                                 sceneName.c_str())
+                             : nullptr;
+                if (!newAnimation)
+                {
+                    return false;
+                }
+                animation = newAnimation.get();
+                swapIn(std::move(artboard), std::move(newAnimation));
+            }
+            animation->time(header.time);
+            animation->direction(header.direction);
+        }
+        else if (header.kind == SnapshotKind::stateMachine)
+        {
+            if (!m_File)
+            {
+                return false;
+            }
+            auto artboard =
+                InstanceArtboard(m_File->file(), artboardName.c_str());
+            auto stateMachine =
+                artboard ? InstanceStateMachine(artboard.get(),
+                                                sceneName.c_str())
+                         : nullptr;
+            if (!stateMachine ||
+                stateMachine->inputCount() != header.inputCount)
+            {
+                return false;
+            }
+            for (uint32_t i = 0; i < header.inputCount; ++i)
+            {
+                float value;
+                memcpy(&value, inputValues + i * sizeof(float), sizeof(float));
+                SMIInput* input = stateMachine->input(i);
+                if (auto number = dynamic_cast<SMINumber*>(input))
+                {
+                    number->value(value);
+                }
+                else if (auto boolean = dynamic_cast<SMIBool*>(input))
+                {
+                    boolean->value(value != 0);
+                }
+            }
+            swapIn(std::move(artboard), std::move(stateMachine));
+        }
+        else
+        {
+            return false;
+        }
+        m_Scene->advanceAndApply(0);
+        return true;
     }
 
-    Scene* scene() { return m_Scene.get(); }
+    // Must match SceneStats in InteropStats.cs.
+    struct Stats
+    {
+        int64_t frameCount;
+        // The most recent frame: everything since the last advanceAndApply().
+        FrameStats frame;
+        // All frames, including the most recent one.
+        FrameStats total;
+    };
+
+    void getStats(Stats* stats) const
+    {
+        stats->frameCount = m_FrameCount;
+        stats->frame = m_FrameStats;
+        stats->total = m_TotalStats;
+        stats->total += m_FrameStats;
+    }
 
 private:
-    std::unique_ptr<FactorySharp> m_Factory;
-    std::unique_ptr<File> m_File;
+    // Fills the buffer with a premultiplied RGBA8888 version of color.
+    static void ClearPixels(uint8_t* pixels,
+                            int32_t width,
+                            int32_t height,
+                            int32_t rowBytes,
+                            ColorInt color)
+    {
+        uint32_t a = color >> 24;
+        uint8_t rgba[4] = {(uint8_t)((((color >> 16) & 0xff) * a + 127) / 255),
+                           (uint8_t)((((color >> 8) & 0xff) * a + 127) / 255),
+                           (uint8_t)(((color & 0xff) * a + 127) / 255),
+                           (uint8_t)a};
+        for (int32_t y = 0; y < height; ++y)
+        {
+            uint8_t* row = pixels + (size_t)y * rowBytes;
+            for (int32_t x = 0; x < width; ++x)
+            {
+                memcpy(row + x * 4, rgba, 4);
+            }
+        }
+    }
+
+    enum class SnapshotKind : uint8_t
+    {
+        animation,
+        stateMachine,
+    };
+
+    // Followed by the artboard name, the scene name, and then a float for
+    // every state machine input.
+    struct SnapshotHeader
+    {
+        uint32_t magic;
+        SnapshotKind kind;
+        float time;
+        int32_t direction;
+        uint32_t artboardNameLength;
+        uint32_t sceneNameLength;
+        uint32_t inputCount;
+    };
+
+    static constexpr uint32_t kSnapshotMagic = 0x50534e52; // "RNSP"
+
+    // In 64 bits, where the 32-bit lengths can't overflow the sum.
+    static uint64_t SnapshotSize(const SnapshotHeader& header)
+    {
+        return sizeof(header) + (uint64_t)header.artboardNameLength +
+               (uint64_t)header.sceneNameLength +
+               (uint64_t)header.inputCount * sizeof(float);
+    }
+
+    // Null names pick the default artboard, or the first scene.
+    static std::unique_ptr<ArtboardInstance> InstanceArtboard(const File* file,
+                                                              const char* name)
+    {
+        return (name && name[0]) ? file->artboardNamed(name)
+                                 : file->artboardDefault();
+    }
+
+    static std::unique_ptr<StateMachineInstance> InstanceStateMachine(
+        ArtboardInstance* artboard,
+        const char* name)
+    {
+        return (name && name[0]) ? artboard->stateMachineNamed(name)
+                                 : artboard->stateMachineAt(0);
+    }
+
+    static std::unique_ptr<LinearAnimationInstance> InstanceAnimation(
+        ArtboardInstance* artboard,
+        const char* name)
+    {
+        return (name && name[0]) ? artboard->animationNamed(name)
+                                 : artboard->animationAt(0);
+    }
+
+    // Replaces the artboard and scene with ones built from m_File.
+    void swapIn(std::unique_ptr<ArtboardInstance> artboard,
+                std::unique_ptr<Scene> scene)
+    {
+        // The old scene references the old artboard, so it goes first.
+        m_Scene.reset();
+        m_Artboard = std::move(artboard);
+        m_Scene = std::move(scene);
+        m_PreviousDrawsStale = true;
+    }
+
+    void unloadFile()
+    {
+        m_Scene.reset();
+        m_Artboard.reset();
+        m_PreviousDrawsStale = true;
+        NativeFile::Release(std::move(m_File));
+    }
+
+    std::shared_ptr<Factory> m_Factory;
+    const bool m_IsSoftware;
+    rcp<NativeFile> m_File;
     std::unique_ptr<ArtboardInstance> m_Artboard;
     std::unique_ptr<Scene> m_Scene;
+    PointerQueue m_PointerQueue;
+    RenderCommandBuffer m_Commands;
+    // The previous and current DirtyTracker passes.
+    std::vector<DirtyTracker::Draw> m_PreviousDraws;
+    std::vector<DirtyTracker::Draw> m_Draws;
+    // Set when the artboard goes away. Its objects' addresses may get reused,
+    // so nothing in m_PreviousDraws can be trusted to still match.
+    bool m_PreviousDrawsStale = false;
+    int64_t m_FrameCount = 0;
+    FrameStats m_FrameStats = {};
+    FrameStats m_TotalStats = {};
 };
 
+NativeScene::Delegates NativeScene::s_delegates{};
+
+RIVE_DLL_VOID Scene_RegisterDelegates(NativeScene::Delegates delegates)
+{
+    NativeScene::s_delegates = delegates;
+}
+
 RIVE_DLL_INTPTR Scene_New(intptr_t managedFactory)
 {
     return reinterpret_cast<intptr_t>(
-        new NativeScene(std::make_unique<FactorySharp>(managedFactory)));
+        new NativeScene(std::make_shared<FactorySharp>(managedFactory)));
+}
+
+RIVE_DLL_INTPTR Scene_NewSoftware()
+{
+    return reinterpret_cast<intptr_t>(
+        new NativeScene(std::make_shared<SoftwareFactory>()));
 }
 
 RIVE_DLL_VOID Scene_Delete(intptr_t ref)
 {
     delete reinterpret_cast<NativeScene*>(ref);
+    ManagedRefReleaser::Flush();
 }
 
 RIVE_DLL_INT8_BOOL Scene_LoadFile(intptr_t ref,
                                   const uint8_t* fileBytes,
                                   int length)
 {
-    return reinterpret_cast<NativeScene*>(ref)->loadFile(fileBytes, length);
+    bool success =
+        reinterpret_cast<NativeScene*>(ref)->loadFile(fileBytes, length);
+    ManagedRefReleaser::Flush();
+    return success;
+}
+
+RIVE_DLL_INT8_BOOL Scene_LoadFromFile(intptr_t ref, intptr_t file)
+{
+    bool success = reinterpret_cast<NativeScene*>(ref)->loadFile(
+        rcp<NativeFile>(safe_ref(reinterpret_cast<NativeFile*>(file))));
+    ManagedRefReleaser::Flush();
+    return success;
 }
 
 RIVE_DLL_INT8_BOOL Scene_LoadArtboard(intptr_t ref, const char* name)
 {
-    return reinterpret_cast<NativeScene*>(ref)->loadArtboard(name);
+    bool success = reinterpret_cast<NativeScene*>(ref)->loadArtboard(name);
+    ManagedRefReleaser::Flush();
+    return success;
 }
 
 RIVE_DLL_INT8_BOOL Scene_LoadStateMachine(intptr_t ref, const char* name)
 {
-    return reinterpret_cast<NativeScene*>(ref)->loadStateMachine(name);
+    bool success = reinterpret_cast<NativeScene*>(ref)->loadStateMachine(name);
+    ManagedRefReleaser::Flush();
+    return success;
 }
 
 RIVE_DLL_INT8_BOOL Scene_LoadAnimation(intptr_t ref, const char* name)
 {
-    return reinterpret_cast<NativeScene*>(ref)->loadAnimation(name);
+    bool success = reinterpret_cast<NativeScene*>(ref)->loadAnimation(name);
+    ManagedRefReleaser::Flush();
+    return success;
 }
 
 RIVE_DLL_INT8_BOOL Scene_SetBool(intptr_t ref, const char* name, int32_t value)
@@ -742,6 +3135,33 @@ RIVE_DLL_INT8_BOOL Scene_FireTrigger(intptr_t ref, const char* name)
     return reinterpret_cast<NativeScene*>(ref)->fireTrigger(name);
 }
 
+RIVE_DLL_INT32 Scene_InputHandle(intptr_t ref, const char* name)
+{
+    return reinterpret_cast<NativeScene*>(ref)->inputHandle(name);
+}
+
+RIVE_DLL_INT8_BOOL Scene_SetBoolAt(intptr_t ref, int32_t handle, int32_t value)
+{
+    return reinterpret_cast<NativeScene*>(ref)->setBoolAt(handle, value);
+}
+
+RIVE_DLL_INT8_BOOL Scene_SetNumberAt(intptr_t ref, int32_t handle, float value)
+{
+    return reinterpret_cast<NativeScene*>(ref)->setNumberAt(handle, value);
+}
+
+RIVE_DLL_INT8_BOOL Scene_FireTriggerAt(intptr_t ref, int32_t handle)
+{
+    return reinterpret_cast<NativeScene*>(ref)->fireTriggerAt(handle);
+}
+
+RIVE_DLL_INT32 Scene_SetInputs(intptr_t ref,
+                               const NativeScene::InputValue* values,
+                               int32_t count)
+{
+    return reinterpret_cast<NativeScene*>(ref)->setInputs(values, count);
+}
+
 RIVE_DLL_FLOAT Scene_Width(intptr_t ref)
 {
     if (Scene* scene = reinterpret_cast<NativeScene*>(ref)->scene())
@@ -804,20 +3224,114 @@ RIVE_DLL_FLOAT Scene_DurationSeconds(intptr_t ref)
 
 RIVE_DLL_INT8_BOOL Scene_AdvanceAndApply(intptr_t ref, float elapsedSeconds)
 {
-    if (Scene* scene = reinterpret_cast<NativeScene*>(ref)->scene())
-    {
-        return scene->advanceAndApply(elapsedSeconds);
-    }
-    return false;
+    bool needsRedraw =
+        reinterpret_cast<NativeScene*>(ref)->advanceAndApply(elapsedSeconds);
+    ManagedRefReleaser::Flush();
+    return needsRedraw;
+}
+
+RIVE_DLL_INT8_BOOL Scene_SeekTo(intptr_t ref, float seconds)
+{
+    bool success = reinterpret_cast<NativeScene*>(ref)->seekTo(seconds);
+    ManagedRefReleaser::Flush();
+    return success;
+}
+
+RIVE_DLL_INT8_BOOL Scene_GetDirtyBounds(intptr_t ref, AABB* bounds)
+{
+    return reinterpret_cast<NativeScene*>(ref)->dirtyBounds(bounds);
+}
+
+RIVE_DLL_INT32 Scene_Snapshot(intptr_t ref, uint8_t* buffer, int32_t capacity)
+{
+    return reinterpret_cast<NativeScene*>(ref)->snapshot(buffer, capacity);
+}
+
+RIVE_DLL_INT8_BOOL Scene_Restore(intptr_t ref,
+                                 const uint8_t* snapshot,
+                                 int32_t length)
+{
+    bool success =
+        reinterpret_cast<NativeScene*>(ref)->restore(snapshot, length);
+    ManagedRefReleaser::Flush();
+    return success;
 }
 
 RIVE_DLL_VOID Scene_Draw(intptr_t ref, intptr_t renderer)
 {
-    if (Scene* scene = reinterpret_cast<NativeScene*>(ref)->scene())
+    reinterpret_cast<NativeScene*>(ref)->drawImmediate(renderer);
+}
+
+RIVE_DLL_VOID Scene_DrawBatched(intptr_t ref, intptr_t renderer)
+{
+    reinterpret_cast<NativeScene*>(ref)->drawBatched(renderer);
+}
+
+// Must match AtlasEntry in RiveAPI.cs.
+struct AtlasEntry
+{
+    intptr_t scene; // NativeScene*
+    AABB frame;
+    int32_t fit;
+    float alignX;
+    float alignY;
+};
+
+// Draws a grid (or any layout) of scenes, each aligned into its own frame,
+// with one reverse P/Invoke for the whole batch. Entries whose frame is
+// entirely outside the viewport are culled without being drawn. Returns the
+// number of scenes drawn.
+RIVE_DLL_INT32 Scene_DrawAtlas(intptr_t renderer,
+                               const AtlasEntry* entries,
+                               int32_t count,
+                               AABB viewport)
+{
+    // Reused between calls, like NativeScene::m_Commands.
+    static thread_local RenderCommandBuffer t_commands;
+    t_commands.reset();
+    RecordingRenderer recorder(&t_commands);
+    int32_t drawn = 0;
+    for (int32_t i = 0; i < count; ++i)
     {
-        RendererSharp nativeRenderer(renderer);
-        return scene->draw(&nativeRenderer);
+        const AtlasEntry& entry = entries[i];
+        const AABB& frame = entry.frame;
+        if (!entry.scene || !(frame.width() > 0 && frame.height() > 0) ||
+            frame.maxX <= viewport.minX || frame.minX >= viewport.maxX ||
+            frame.maxY <= viewport.minY || frame.minY >= viewport.maxY)
+        {
+            continue;
+        }
+        reinterpret_cast<NativeScene*>(entry.scene)
+            ->recordAligned(&recorder,
+                            (Fit)entry.fit,
+                            Alignment(entry.alignX, entry.alignY),
+                            frame);
+        ++drawn;
     }
+    t_commands.playback(renderer);
+    return drawn;
+}
+
+RIVE_DLL_INT8_BOOL Scene_DrawSoftware(intptr_t ref,
+                                      uint8_t* pixels,
+                                      int32_t width,
+                                      int32_t height,
+                                      int32_t rowBytes,
+                                      Mat2D transform)
+{
+    return reinterpret_cast<NativeScene*>(ref)
+        ->drawSoftware(pixels, width, height, rowBytes, transform);
+}
+
+RIVE_DLL_INT32 Scene_RenderSequence(intptr_t ref,
+                                    const RenderSequenceArgs* args)
+{
+    return reinterpret_cast<NativeScene*>(ref)->renderSequence(*args);
+}
+
+RIVE_DLL_VOID Scene_GetStats(intptr_t ref, NativeScene::Stats* stats)
+{
+    reinterpret_cast<NativeScene*>(ref)->getStats(stats);
 }
 
 RIVE_DLL_VOID Scene_PointerDown(intptr_t ref, Vec2D pos)
@@ -843,3 +3357,110 @@ RIVE_DLL_VOID Scene_PointerUp(intptr_t ref, Vec2D pos)
         scene->pointerUp(pos);
     }
 }
+
+// May be called from any thread.
+RIVE_DLL_VOID Scene_SetPointerTransform(intptr_t ref, Mat2D viewToArtboard)
+{
+    reinterpret_cast<NativeScene*>(ref)->pointerQueue()->setTransform(
+        viewToArtboard);
+}
+
+// May be called from any thread. The event is dispatched at the start of the
+// next Scene_AdvanceAndApply.
+RIVE_DLL_VOID Scene_QueuePointerEvent(intptr_t ref,
+                                      PointerEventType type,
+                                      Vec2D viewPosition)
+{
+    reinterpret_cast<NativeScene*>(ref)->pointerQueue()->push(type,
+                                                              viewPosition);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A set of independent NativeScenes that get advanced together, in parallel,
+// on the shared WorkerPool.
+class SceneGroup
+{
+public:
+    // Returns false if the scene is already in the group. Workers advance each
+    // entry independently, so a scene must never appear twice.
+    bool add(NativeScene* scene)
+    {
+        if (std::find(m_scenes.begin(), m_scenes.end(), scene) !=
+            m_scenes.end())
+        {
+            return false;
+        }
+        m_scenes.push_back(scene);
+        return true;
+    }
+
+    void remove(NativeScene* scene)
+    {
+        m_scenes.erase(std::remove(m_scenes.begin(), m_scenes.end(), scene),
+                       m_scenes.end());
+    }
+
+    int32_t count() const { return (int32_t)m_scenes.size(); }
+
+    // Advances every scene and sets bit i of needsRedraw (LSB first) iff the
+    // scene at index i needs to be drawn. Returns the number of such scenes.
+    int32_t advanceAll(float elapsedSeconds, uint8_t* needsRedraw)
+    {
+        size_t n = m_scenes.size();
+        m_results.resize(n);
+        WorkerPool::Shared()->parallelFor(n, [&](size_t i) {
+            m_results[i] = m_scenes[i]->advanceAndApply(elapsedSeconds);
+        });
+        memset(needsRedraw, 0, (n + 7) / 8);
+        int32_t redrawCount = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (m_results[i])
+            {
+                needsRedraw[i / 8] |= 1 << (i % 8);
+                ++redrawCount;
+            }
+        }
+        return redrawCount;
+    }
+
+private:
+    std::vector<NativeScene*> m_scenes;
+    // One byte per scene, so workers never write to the same byte.
+    std::vector<uint8_t> m_results;
+};
+
+RIVE_DLL_INTPTR SceneGroup_New()
+{
+    return reinterpret_cast<intptr_t>(new SceneGroup());
+}
+
+RIVE_DLL_VOID SceneGroup_Delete(intptr_t ref)
+{
+    delete reinterpret_cast<SceneGroup*>(ref);
+    ManagedRefReleaser::Flush();
+}
+
+RIVE_DLL_INT8_BOOL SceneGroup_Add(intptr_t ref, intptr_t scene)
+{
+    return reinterpret_cast<SceneGroup*>(ref)->add(
+        reinterpret_cast<NativeScene*>(scene));
+}
+
+RIVE_DLL_VOID SceneGroup_Remove(intptr_t ref, intptr_t scene)
+{
+    reinterpret_cast<SceneGroup*>(ref)->remove(
+        reinterpret_cast<NativeScene*>(scene));
+}
+
+RIVE_DLL_INT32 SceneGroup_AdvanceAll(intptr_t ref,
+                                     float elapsedSeconds,
+                                     uint8_t* needsRedraw)
+{
+    int32_t redrawCount =
+        reinterpret_cast<SceneGroup*>(ref)->advanceAll(elapsedSeconds,
+                                                       needsRedraw);
+    ManagedRefReleaser::Flush();
+    return redrawCount;
+}
@@ -0,0 +1,1125 @@
+#include "SoftwareRenderer.hpp"
+#include "MathKernels.hpp"
+#include "utils/factory_utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using namespace rive;
+
+// Maximum distance, in pixels, between a curve and the polyline that
+// approximates it.
+constexpr static float kFlattenTolerance = .25f;
+constexpr static float kMiterLimit = 4;
+constexpr static float kPI = 3.14159265358979f;
+
+static float Dot(Vec2D a, Vec2D b) { return a.x * b.x + a.y * b.y; }
+static float Cross(Vec2D a, Vec2D b) { return a.x * b.y - a.y * b.x; }
+static float Length(Vec2D a) { return sqrtf(Dot(a, a)); }
+static Vec2D Add(Vec2D a, Vec2D b) { return Vec2D(a.x + b.x, a.y + b.y); }
+static Vec2D Sub(Vec2D a, Vec2D b) { return Vec2D(a.x - b.x, a.y - b.y); }
+static Vec2D Scale(Vec2D a, float s) { return Vec2D(a.x * s, a.y * s); }
+static Vec2D Perp(Vec2D a) { return Vec2D(-a.y, a.x); }
+
+// Largest factor by which the matrix stretches any vector.
+static float MaxScale(const Mat2D& m)
+{
+    float a = m.xx(), b = m.xy(), c = m.yx(), d = m.yy();
+    float e = (a * a + b * b + c * c + d * d) / 2;
+    float f = sqrtf(((a * a + b * b - c * c - d * d) / 2) *
+                        ((a * a + b * b - c * c - d * d) / 2) +
+                    (a * c + b * d) * (a * c + b * d));
+    return sqrtf(e + f);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SoftwareRenderPath : public RenderPath
+{
+public:
+    SoftwareRenderPath() = default;
+    SoftwareRenderPath(const RawPath& rawPath, FillRule fillRule) :
+        m_fillRule(fillRule)
+    {
+        m_rawPath.addPath(rawPath);
+    }
+
+    void rewind() override { m_rawPath.rewind(); }
+    void fillRule(FillRule value) override { m_fillRule = value; }
+    void addRenderPath(RenderPath* path, const Mat2D& m) override
+    {
+        m_rawPath.addPath(static_cast<SoftwareRenderPath*>(path)->m_rawPath,
+                          &m);
+    }
+    void moveTo(float x, float y) override { m_rawPath.moveTo(x, y); }
+    void lineTo(float x, float y) override { m_rawPath.lineTo(x, y); }
+    void cubicTo(float ox, float oy, float ix, float iy, float x, float y)
+        override
+    {
+        m_rawPath.cubicTo(ox, oy, ix, iy, x, y);
+    }
+    void close() override { m_rawPath.close(); }
+
+    const RawPath& rawPath() const { return m_rawPath; }
+    FillRule fillRuleValue() const { return m_fillRule; }
+
+private:
+    RawPath m_rawPath;
+    FillRule m_fillRule = FillRule::nonZero;
+};
+
+// Premultiplied, normalized RGBA.
+struct Color4f
+{
+    float r, g, b, a;
+
+    static Color4f FromColorInt(ColorInt c)
+    {
+        float a = (c >> 24) / 255.f;
+        return {((c >> 16) & 0xff) / 255.f * a,
+                ((c >> 8) & 0xff) / 255.f * a,
+                (c & 0xff) / 255.f * a,
+                a};
+    }
+};
+
+class SoftwareGradient : public RenderShader
+{
+public:
+    static constexpr int kLUTSize = 256;
+
+    // Rasterizes the color ramp into m_lut. Colors are interpolated
+    // unpremultiplied, like Skia does, and premultiplied afterwards.
+    SoftwareGradient(const ColorInt colors[], const float stops[], size_t n)
+    {
+        size_t stop = 0;
+        for (int i = 0; i < kLUTSize; ++i)
+        {
+            float t = i / (float)(kLUTSize - 1);
+            while (stop + 1 < n && stops[stop + 1] < t)
+            {
+                ++stop;
+            }
+            ColorInt c0 = colors[stop];
+            ColorInt c1 = colors[std::min(stop + 1, n - 1)];
+            float t0 = stops[stop];
+            float t1 = stops[std::min(stop + 1, n - 1)];
+            float w = t1 > t0 ? std::min(std::max((t - t0) / (t1 - t0), 0.f),
+                                         1.f)
+                              : (t < t0 ? 0.f : 1.f);
+            auto lerp = [w](ColorInt c0, ColorInt c1, int shift) {
+                float a = ((c0 >> shift) & 0xff) / 255.f;
+                float b = ((c1 >> shift) & 0xff) / 255.f;
+                return a + (b - a) * w;
+            };
+            float a = lerp(c0, c1, 24);
+            m_lut[i] = {lerp(c0, c1, 16) * a,
+                        lerp(c0, c1, 8) * a,
+                        lerp(c0, c1, 0) * a,
+                        a};
+        }
+    }
+
+    const Color4f& colorAt(float t) const
+    {
+        t = std::min(std::max(t, 0.f), 1.f);
+        return m_lut[(int)(t * (kLUTSize - 1) + .5f)];
+    }
+
+    // Linear gradients evaluate t as an affine function of local coordinates.
+    // Radial gradients evaluate t = |local - center| / radius.
+    virtual bool isRadial() const = 0;
+
+private:
+    Color4f m_lut[kLUTSize];
+};
+
+class SoftwareLinearGradient : public SoftwareGradient
+{
+public:
+    SoftwareLinearGradient(Vec2D start,
+                           Vec2D end,
+                           const ColorInt colors[],
+                           const float stops[],
+                           size_t n) :
+        SoftwareGradient(colors, stops, n), start(start), end(end)
+    {}
+    bool isRadial() const override { return false; }
+    const Vec2D start, end;
+};
+
+class SoftwareRadialGradient : public SoftwareGradient
+{
+public:
+    SoftwareRadialGradient(Vec2D center,
+                           float radius,
+                           const ColorInt colors[],
+                           const float stops[],
+                           size_t n) :
+        SoftwareGradient(colors, stops, n), center(center), radius(radius)
+    {}
+    bool isRadial() const override { return true; }
+    const Vec2D center;
+    const float radius;
+};
+
+class SoftwareRenderPaint : public RenderPaint
+{
+public:
+    void style(RenderPaintStyle value) override { m_style = value; }
+    void color(ColorInt value) override { m_color = value; }
+    void thickness(float value) override { m_thickness = value; }
+    void join(StrokeJoin value) override { m_join = value; }
+    void cap(StrokeCap value) override { m_cap = value; }
+    void blendMode(BlendMode value) override { m_blendMode = value; }
+    void shader(rcp<RenderShader> shader) override
+    {
+        m_shader = rcp<SoftwareGradient>(
+            static_cast<SoftwareGradient*>(shader.release()));
+    }
+    void invalidateStroke() override {}
+
+    RenderPaintStyle styleValue() const { return m_style; }
+    ColorInt colorValue() const { return m_color; }
+    float thicknessValue() const { return m_thickness; }
+    StrokeJoin joinValue() const { return m_join; }
+    StrokeCap capValue() const { return m_cap; }
+    BlendMode blendModeValue() const { return m_blendMode; }
+    const SoftwareGradient* gradient() const { return m_shader.get(); }
+
+private:
+    RenderPaintStyle m_style = RenderPaintStyle::fill;
+    ColorInt m_color = 0xff000000;
+    float m_thickness = 1;
+    StrokeJoin m_join = StrokeJoin::miter;
+    StrokeCap m_cap = StrokeCap::butt;
+    BlendMode m_blendMode = BlendMode::srcOver;
+    rcp<SoftwareGradient> m_shader;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+rcp<RenderBuffer> SoftwareFactory::makeRenderBuffer(RenderBufferType type,
+                                                    RenderBufferFlags flags,
+                                                    size_t sizeInBytes)
+{
+    return make_rcp<DataRenderBuffer>(type, flags, sizeInBytes);
+}
+
+rcp<RenderShader> SoftwareFactory::makeLinearGradient(float sx,
+                                                      float sy,
+                                                      float ex,
+                                                      float ey,
+                                                      const ColorInt colors[],
+                                                      const float stops[],
+                                                      size_t count)
+{
+    if (count == 0)
+    {
+        return nullptr;
+    }
+    return make_rcp<SoftwareLinearGradient>(Vec2D(sx, sy),
+                                            Vec2D(ex, ey),
+                                            colors,
+                                            stops,
+                                            count);
+}
+
+rcp<RenderShader> SoftwareFactory::makeRadialGradient(float cx,
+                                                      float cy,
+                                                      float radius,
+                                                      const ColorInt colors[],
+                                                      const float stops[],
+                                                      size_t count)
+{
+    if (count == 0)
+    {
+        return nullptr;
+    }
+    return make_rcp<SoftwareRadialGradient>(Vec2D(cx, cy),
+                                            radius,
+                                            colors,
+                                            stops,
+                                            count);
+}
+
+rcp<RenderPath> SoftwareFactory::makeRenderPath(RawPath& rawPath,
+                                                FillRule fillRule)
+{
+    return make_rcp<SoftwareRenderPath>(rawPath, fillRule);
+}
+
+rcp<RenderPath> SoftwareFactory::makeEmptyRenderPath()
+{
+    return make_rcp<SoftwareRenderPath>();
+}
+
+rcp<RenderPaint> SoftwareFactory::makeRenderPaint()
+{
+    return make_rcp<SoftwareRenderPaint>();
+}
+
+rcp<RenderImage> SoftwareFactory::decodeImage(Span<const uint8_t>)
+{
+    m_undecodedImageCount.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A polyline. Fills treat every contour as closed.
+struct Contour
+{
+    std::vector<Vec2D> points;
+    bool closed = false;
+};
+
+// Converts a path to polylines, mapping each point through m. Curves are
+// subdivided in local space, and then each contour is transformed as a batch.
+static void Flatten(const RawPath& path,
+                    const Mat2D& m,
+                    float tolerance,
+                    std::vector<Contour>* contours)
+{
+    contours->clear();
+    const Vec2D* pts = path.points().data();
+    Vec2D pen, start;
+    auto emit = [&](Vec2D p) {
+        if (contours->empty())
+        {
+            contours->emplace_back();
+        }
+        contours->back().points.push_back(p);
+    };
+    for (PathVerb verb : path.verbs())
+    {
+        switch (verb)
+        {
+            case PathVerb::move:
+                contours->emplace_back();
+                pen = start = *pts++;
+                emit(pen);
+                break;
+            case PathVerb::line:
+                pen = *pts++;
+                emit(pen);
+                break;
+            case PathVerb::quad:
+            {
+                Vec2D p0 = pen, p1 = pts[0], p2 = pts[1];
+                pts += 2;
+                // Wang's formula, in device space.
+                Vec2D dd = Sub(Add(m * p0, m * p2), Scale(m * p1, 2));
+                int n = (int)ceilf(sqrtf(.25f * Length(dd) / tolerance));
+                n = std::min(std::max(n, 1), 256);
+                for (int i = 1; i <= n; ++i)
+                {
+                    float t = i / (float)n, u = 1 - t;
+                    emit(Add(Add(Scale(p0, u * u), Scale(p1, 2 * u * t)),
+                             Scale(p2, t * t)));
+                }
+                pen = p2;
+                break;
+            }
+            case PathVerb::cubic:
+            {
+                Vec2D p0 = pen, p1 = pts[0], p2 = pts[1], p3 = pts[2];
+                pts += 3;
+                Vec2D d0 = Sub(Add(m * p0, m * p2), Scale(m * p1, 2));
+                Vec2D d1 = Sub(Add(m * p1, m * p3), Scale(m * p2, 2));
+                float dd = std::max(Length(d0), Length(d1));
+                int n = (int)ceilf(sqrtf(.75f * dd / tolerance));
+                n = std::min(std::max(n, 1), 256);
+                for (int i = 1; i <= n; ++i)
+                {
+                    float t = i / (float)n, u = 1 - t;
+                    emit(Add(Add(Scale(p0, u * u * u),
+                                 Scale(p1, 3 * u * u * t)),
+                             Add(Scale(p2, 3 * u * t * t),
+                                 Scale(p3, t * t * t))));
+                }
+                pen = p3;
+                break;
+            }
+            case PathVerb::close:
+                if (!contours->empty())
+                {
+                    contours->back().closed = true;
+                }
+                pen = start;
+                break;
+            default:
+                assert(false);
+                break;
+        }
+    }
+    for (Contour& contour : *contours)
+    {
+        kernels::TransformPoints(m,
+                                 contour.points.data(),
+                                 contour.points.data(),
+                                 contour.points.size());
+    }
+}
+
+// Signed edges of a set of closed polygons, and the scanline converter that
+// turns them into per-pixel coverage.
+class SoftwareRenderer::EdgeList
+{
+public:
+    void reset() { m_edges.clear(); }
+    bool empty() const { return m_edges.empty(); }
+
+    void addPolygon(const Vec2D* pts, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vec2D a = pts[i];
+            Vec2D b = pts[i + 1 < n ? i + 1 : 0];
+            if (a.y == b.y || !std::isfinite(a.x + a.y + b.x + b.y))
+            {
+                continue;
+            }
+            Edge edge;
+            edge.winding = a.y < b.y ? 1 : -1;
+            if (a.y > b.y)
+            {
+                std::swap(a, b);
+            }
+            edge.x0 = a.x;
+            edge.y0 = a.y;
+            edge.y1 = b.y;
+            edge.dxdy = (b.x - a.x) / (b.y - a.y);
+            m_edges.push_back(edge);
+        }
+    }
+
+    // Adds the polygon with counterclockwise orientation, so that overlapping
+    // stroke pieces union together under the nonZero fill rule.
+    void addPositivePolygon(std::vector<Vec2D>& pts)
+    {
+        float area = 0;
+        for (size_t i = 0, n = pts.size(); i < n; ++i)
+        {
+            area += Cross(pts[i], pts[(i + 1) % n]);
+        }
+        if (area < 0)
+        {
+            std::reverse(pts.begin(), pts.end());
+        }
+        addPolygon(pts.data(), pts.size());
+    }
+
+    // Pixel bounds of the edges, intersected with clip.
+    IRect bounds(const IRect& clip) const
+    {
+        if (m_edges.empty() || clip.empty())
+        {
+            return {0, 0, 0, 0};
+        }
+        float minX = m_edges[0].x0, maxX = minX;
+        float minY = m_edges[0].y0, maxY = m_edges[0].y1;
+        for (const Edge& e : m_edges)
+        {
+            float x1 = e.x0 + (e.y1 - e.y0) * e.dxdy;
+            minX = std::min(minX, std::min(e.x0, x1));
+            maxX = std::max(maxX, std::max(e.x0, x1));
+            minY = std::min(minY, e.y0);
+            maxY = std::max(maxY, e.y1);
+        }
+        return {std::max(clip.left, (int32_t)floorf(minX)),
+                std::max(clip.top, (int32_t)floorf(minY)),
+                std::min(clip.right, (int32_t)ceilf(maxX)),
+                std::min(clip.bottom, (int32_t)ceilf(maxY))};
+    }
+
+    // Calls blit(y, left, right, coverage[right - left]) for every row that
+    // has coverage inside the clip rect.
+    void rasterize(FillRule fillRule,
+                   const IRect& clip,
+                   const std::function<
+                       void(int32_t y, int32_t l, int32_t r, const float*)>&
+                       blit)
+    {
+        IRect bounds = this->bounds(clip);
+        if (bounds.empty())
+        {
+            return;
+        }
+
+        std::sort(m_edges.begin(),
+                  m_edges.end(),
+                  [](const Edge& a, const Edge& b) { return a.y0 < b.y0; });
+
+        int32_t width = bounds.right - bounds.left;
+        m_accumulation.assign(width + 2, 0);
+        m_coverage.resize(width);
+        m_active.clear();
+        size_t nextEdge = 0;
+        constexpr float weight = 1.f / kSubsamples;
+        uint32_t windingMask = fillRule == FillRule::evenOdd ? 1 : ~0u;
+
+        for (int32_t y = bounds.top; y < bounds.bottom; ++y)
+        {
+            int32_t spanMin = width + 2, spanMax = -1;
+            for (int s = 0; s < kSubsamples; ++s)
+            {
+                float sampleY = y + (s + .5f) / kSubsamples;
+                while (nextEdge < m_edges.size() &&
+                       m_edges[nextEdge].y0 <= sampleY)
+                {
+                    m_active.push_back(&m_edges[nextEdge++]);
+                }
+                m_crossings.clear();
+                size_t keep = 0;
+                for (const Edge* e : m_active)
+                {
+                    if (e->y1 <= sampleY)
+                    {
+                        continue;
+                    }
+                    m_active[keep++] = e;
+                    if (e->y0 <= sampleY)
+                    {
+                        m_crossings.push_back(
+                            {e->x0 + (sampleY - e->y0) * e->dxdy - bounds.left,
+                             e->winding});
+                    }
+                }
+                m_active.resize(keep);
+                std::sort(m_crossings.begin(),
+                          m_crossings.end(),
+                          [](const Crossing& a, const Crossing& b) {
+                              return a.x < b.x;
+                          });
+                int winding = 0;
+                for (size_t i = 0; i + 1 < m_crossings.size(); ++i)
+                {
+                    winding += m_crossings[i].winding;
+                    if ((winding & windingMask) == 0)
+                    {
+                        continue;
+                    }
+                    float xa = std::max(m_crossings[i].x, 0.f);
+                    float xb = std::min(m_crossings[i + 1].x, (float)width);
+                    if (xa >= xb)
+                    {
+                        continue;
+                    }
+                    // Coverage of pixel i by [xa, xb) is g(xa, i) - g(xb, i),
+                    // where g steps from 0 to 1 across the pixel containing x.
+                    // Accumulate its differences so a prefix sum recovers it.
+                    int32_t ia = (int32_t)xa, ib = (int32_t)xb;
+                    float fa = xa - ia, fb = xb - ib;
+                    m_accumulation[ia] += (1 - fa) * weight;
+                    m_accumulation[ia + 1] += fa * weight;
+                    m_accumulation[ib] -= (1 - fb) * weight;
+                    m_accumulation[ib + 1] -= fb * weight;
+                    spanMin = std::min(spanMin, ia);
+                    spanMax = std::max(spanMax, ib + 1);
+                }
+            }
+            if (spanMax < 0)
+            {
+                continue;
+            }
+            float sum = 0;
+            int32_t end = std::min(spanMax, width);
+            for (int32_t x = spanMin; x < end; ++x)
+            {
+                sum += m_accumulation[x];
+                m_accumulation[x] = 0;
+                m_coverage[x] = std::min(fabsf(sum), 1.f);
+            }
+            for (int32_t x = end; x <= spanMax; ++x)
+            {
+                m_accumulation[x] = 0;
+            }
+            if (spanMin < end)
+            {
+                blit(y,
+                     bounds.left + spanMin,
+                     bounds.left + end,
+                     m_coverage.data() + spanMin);
+            }
+        }
+    }
+
+    // Scratch storage for stroking, reused between draws.
+    std::vector<Contour> contours;
+    std::vector<Vec2D> polygon;
+
+private:
+    struct Edge
+    {
+        float x0, y0; // Top endpoint.
+        float y1;
+        float dxdy;
+        int winding;
+    };
+
+    struct Crossing
+    {
+        float x;
+        int winding;
+    };
+
+    std::vector<Edge> m_edges;
+    std::vector<const Edge*> m_active;
+    std::vector<Crossing> m_crossings;
+    std::vector<float> m_accumulation;
+    std::vector<float> m_coverage;
+};
+
+// An 8-bit coverage mask over bounds. Everything outside bounds is clipped out.
+struct SoftwareRenderer::ClipMask
+{
+    IRect bounds;
+    std::vector<uint8_t> alpha; // [bounds height][bounds width]
+
+    // Coverage of row y, indexed by x - bounds.left.
+    uint8_t* row(int32_t y)
+    {
+        return alpha.data() +
+               (size_t)(y - bounds.top) * (bounds.right - bounds.left);
+    }
+    const uint8_t* row(int32_t y) const
+    {
+        return const_cast<ClipMask*>(this)->row(y);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Separable blend modes, per the W3C compositing spec. Inputs are
+// unpremultiplied.
+static float BlendChannel(BlendMode mode, float cb, float cs)
+{
+    switch (mode)
+    {
+        case BlendMode::screen:
+            return cb + cs - cb * cs;
+        case BlendMode::overlay:
+            return BlendChannel(BlendMode::hardLight, cs, cb);
+        case BlendMode::darken:
+            return std::min(cb, cs);
+        case BlendMode::lighten:
+            return std::max(cb, cs);
+        case BlendMode::colorDodge:
+            if (cb == 0)
+            {
+                return 0;
+            }
+            return cs >= 1 ? 1 : std::min(1.f, cb / (1 - cs));
+        case BlendMode::colorBurn:
+            if (cb >= 1)
+            {
+                return 1;
+            }
+            return cs <= 0 ? 0 : 1 - std::min(1.f, (1 - cb) / cs);
+        case BlendMode::hardLight:
+            return cs <= .5f
+                       ? cb * 2 * cs
+                       : BlendChannel(BlendMode::screen, cb, 2 * cs - 1);
+        case BlendMode::softLight:
+        {
+            if (cs <= .5f)
+            {
+                return cb - (1 - 2 * cs) * cb * (1 - cb);
+            }
+            float d = cb <= .25f ? ((16 * cb - 12) * cb + 4) * cb : sqrtf(cb);
+            return cb + (2 * cs - 1) * (d - cb);
+        }
+        case BlendMode::difference:
+            return fabsf(cb - cs);
+        case BlendMode::exclusion:
+            return cb + cs - 2 * cb * cs;
+        case BlendMode::multiply:
+            return cb * cs;
+        default:
+            return cs;
+    }
+}
+
+static float Lum(const float c[3])
+{
+    return .3f * c[0] + .59f * c[1] + .11f * c[2];
+}
+
+static void SetLum(float c[3], float l)
+{
+    float d = l - Lum(c);
+    for (int i = 0; i < 3; ++i)
+    {
+        c[i] += d;
+    }
+    l = Lum(c);
+    float n = std::min(c[0], std::min(c[1], c[2]));
+    float x = std::max(c[0], std::max(c[1], c[2]));
+    for (int i = 0; i < 3; ++i)
+    {
+        if (n < 0 && l - n != 0)
+        {
+            c[i] = l + (c[i] - l) * l / (l - n);
+        }
+        if (x > 1 && x - l != 0)
+        {
+            c[i] = l + (c[i] - l) * (1 - l) / (x - l);
+        }
+    }
+}
+
+static float Sat(const float c[3])
+{
+    return std::max(c[0], std::max(c[1], c[2])) -
+           std::min(c[0], std::min(c[1], c[2]));
+}
+
+static void SetSat(float c[3], float s)
+{
+    int order[3] = {0, 1, 2};
+    std::sort(order, order + 3, [c](int a, int b) { return c[a] < c[b]; });
+    float& cmin = c[order[0]];
+    float& cmid = c[order[1]];
+    float& cmax = c[order[2]];
+    if (cmax > cmin)
+    {
+        cmid = (cmid - cmin) * s / (cmax - cmin);
+        cmax = s;
+    }
+    else
+    {
+        cmid = cmax = 0;
+    }
+    cmin = 0;
+}
+
+// Composites premultiplied src over dst[4] (premultiplied RGBA8888).
+static void BlendPixel(BlendMode mode, const Color4f& src, uint8_t* dst)
+{
+    float d[4] =
+        {dst[0] / 255.f, dst[1] / 255.f, dst[2] / 255.f, dst[3] / 255.f};
+    float s[4] = {src.r, src.g, src.b, src.a};
+    float out[4];
+    if (mode == BlendMode::srcOver || d[3] == 0 || s[3] == 0)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out[i] = s[i] + d[i] * (1 - s[3]);
+        }
+    }
+    else
+    {
+        float cb[3], cs[3], b[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            cb[i] = std::min(d[i] / d[3], 1.f);
+            cs[i] = std::min(s[i] / s[3], 1.f);
+        }
+        switch (mode)
+        {
+            case BlendMode::hue:
+                std::copy(cs, cs + 3, b);
+                SetSat(b, Sat(cb));
+                SetLum(b, Lum(cb));
+                break;
+            case BlendMode::saturation:
+                std::copy(cb, cb + 3, b);
+                SetSat(b, Sat(cs));
+                SetLum(b, Lum(cb));
+                break;
+            case BlendMode::color:
+                std::copy(cs, cs + 3, b);
+                SetLum(b, Lum(cb));
+                break;
+            case BlendMode::luminosity:
+                std::copy(cb, cb + 3, b);
+                SetLum(b, Lum(cs));
+                break;
+            default:
+                for (int i = 0; i < 3; ++i)
+                {
+                    b[i] = BlendChannel(mode, cb[i], cs[i]);
+                }
+                break;
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            out[i] =
+                s[i] * (1 - d[3]) + d[i] * (1 - s[3]) + s[3] * d[3] * b[i];
+        }
+        out[3] = s[3] + d[3] * (1 - s[3]);
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        dst[i] = (uint8_t)(std::min(std::max(out[i], 0.f), 1.f) * 255 + .5f);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SoftwareRenderer::SoftwareRenderer(uint8_t* pixels,
+                                   int32_t width,
+                                   int32_t height,
+                                   int32_t rowBytes) :
+    m_pixels(pixels),
+    m_width(width),
+    m_height(height),
+    m_rowBytes(rowBytes),
+    m_edges(new EdgeList())
+{
+    m_stack.push_back({Mat2D(), nullptr, {0, 0, width, height}});
+}
+
+SoftwareRenderer::~SoftwareRenderer() {}
+
+std::shared_ptr<SoftwareRenderer::ClipMask> SoftwareRenderer::makeClipMask(
+    const IRect& bounds)
+{
+    std::unique_ptr<ClipMask> mask;
+    if (m_maskPool.empty())
+    {
+        mask.reset(new ClipMask());
+    }
+    else
+    {
+        mask = std::move(m_maskPool.back());
+        m_maskPool.pop_back();
+    }
+    mask->bounds = bounds;
+    size_t area = bounds.empty() ? 0
+                                 : (size_t)(bounds.right - bounds.left) *
+                                       (bounds.bottom - bounds.top);
+    mask->alpha.assign(area, 0);
+    // Masks only live in m_stack, which is destroyed before m_maskPool.
+    return std::shared_ptr<ClipMask>(mask.release(),
+                                     [this](ClipMask* released) {
+                                         m_maskPool.emplace_back(released);
+                                     });
+}
+
+void SoftwareRenderer::save() { m_stack.push_back(m_stack.back()); }
+
+void SoftwareRenderer::restore()
+{
+    if (m_stack.size() > 1)
+    {
+        m_stack.pop_back();
+    }
+}
+
+void SoftwareRenderer::transform(const Mat2D& m)
+{
+    m_stack.back().matrix = m_stack.back().matrix * m;
+}
+
+bool SoftwareRenderer::buildEdges(RenderPath* path,
+                                  RenderPaint* paint,
+                                  FillRule* fillRule)
+{
+    auto swPath = static_cast<SoftwareRenderPath*>(path);
+    auto swPaint = static_cast<SoftwareRenderPaint*>(paint);
+    const Mat2D& matrix = m_stack.back().matrix;
+    EdgeList& edges = *m_edges;
+    std::vector<Contour>& contours = edges.contours;
+    edges.reset();
+
+    if (!swPaint || swPaint->styleValue() == RenderPaintStyle::fill)
+    {
+        Flatten(swPath->rawPath(), matrix, kFlattenTolerance, &contours);
+        for (const Contour& contour : contours)
+        {
+            edges.addPolygon(contour.points.data(), contour.points.size());
+        }
+        *fillRule = swPath->fillRuleValue();
+        return !edges.empty();
+    }
+
+    // Strokes are built in local space, as the union of one quad per
+    // segment plus polygons for the joins and caps, and then mapped to device
+    // space.
+    float radius = swPaint->thicknessValue() / 2;
+    float scale = MaxScale(matrix);
+    if (!(radius > 0) || !(scale > 0))
+    {
+        return false;
+    }
+    float tolerance = kFlattenTolerance / scale;
+    Flatten(swPath->rawPath(), Mat2D(), tolerance, &contours);
+    StrokeJoin join = swPaint->joinValue();
+    StrokeCap cap = swPaint->capValue();
+    std::vector<Vec2D>& polygon = edges.polygon;
+
+    auto addPolygon = [&]() {
+        for (Vec2D& p : polygon)
+        {
+            p = matrix * p;
+        }
+        edges.addPositivePolygon(polygon);
+    };
+    auto addCircle = [&](Vec2D center) {
+        float deviceRadius = radius * scale;
+        int n = deviceRadius > kFlattenTolerance
+                    ? (int)ceilf(kPI / acosf(1 - kFlattenTolerance /
+                                                     deviceRadius))
+                    : 4;
+        n = std::min(std::max(n, 4), 256);
+        polygon.clear();
+        for (int i = 0; i < n; ++i)
+        {
+            float theta = 2 * kPI * i / n;
+            polygon.push_back(Add(center,
+                                  Vec2D(cosf(theta) * radius,
+                                        sinf(theta) * radius)));
+        }
+        addPolygon();
+    };
+
+    for (Contour& contour : contours)
+    {
+        std::vector<Vec2D>& pts = contour.points;
+        pts.erase(std::unique(pts.begin(),
+                              pts.end(),
+                              [](Vec2D a, Vec2D b) {
+                                  return a.x == b.x && a.y == b.y;
+                              }),
+                  pts.end());
+        bool closed = contour.closed;
+        if (closed && pts.size() > 1 && pts.front().x == pts.back().x &&
+            pts.front().y == pts.back().y)
+        {
+            pts.pop_back();
+        }
+        size_t n = pts.size();
+        if (n < 2)
+        {
+            if (n == 1 && cap == StrokeCap::round)
+            {
+                addCircle(pts[0]);
+            }
+            continue;
+        }
+
+        size_t segmentCount = closed ? n : n - 1;
+        for (size_t i = 0; i < segmentCount; ++i)
+        {
+            Vec2D a = pts[i], b = pts[(i + 1) % n];
+            Vec2D dir = Scale(Sub(b, a), 1 / Length(Sub(b, a)));
+            if (!closed && cap == StrokeCap::square)
+            {
+                if (i == 0)
+                {
+                    a = Sub(a, Scale(dir, radius));
+                }
+                if (i == segmentCount - 1)
+                {
+                    b = Add(b, Scale(dir, radius));
+                }
+            }
+            Vec2D offset = Scale(Perp(dir), radius);
+            polygon = {Add(a, offset),
+                       Add(b, offset),
+                       Sub(b, offset),
+                       Sub(a, offset)};
+            addPolygon();
+        }
+
+        // Joins.
+        size_t first = closed ? 0 : 1;
+        size_t last = closed ? n : n - 1;
+        for (size_t i = first; i < last; ++i)
+        {
+            Vec2D p = pts[i];
+            Vec2D d0 = Sub(p, pts[(i + n - 1) % n]);
+            Vec2D d1 = Sub(pts[(i + 1) % n], p);
+            d0 = Scale(d0, 1 / Length(d0));
+            d1 = Scale(d1, 1 / Length(d1));
+            float turn = Cross(d0, d1);
+            if (join == StrokeJoin::round)
+            {
+                addCircle(p);
+                continue;
+            }
+            if (fabsf(turn) < 1e-6f && Dot(d0, d1) > 0)
+            {
+                continue; // Collinear.
+            }
+            // The outer side of the corner is opposite to the turn.
+            float side = turn > 0 ? -radius : radius;
+            Vec2D a = Add(p, Scale(Perp(d0), side));
+            Vec2D b = Add(p, Scale(Perp(d1), side));
+            polygon = {p, a, b};
+            if (join == StrokeJoin::miter)
+            {
+                Vec2D bisector = Add(Perp(d0), Perp(d1));
+                float len = Length(bisector);
+                if (len > 0)
+                {
+                    bisector = Scale(bisector, 1 / len);
+                    // 1 / cos(theta / 2), where theta is the angle between the
+                    // segment normals.
+                    float miterRatio = 1 / Dot(bisector, Perp(d0));
+                    if (miterRatio <= kMiterLimit)
+                    {
+                        polygon = {p,
+                                   a,
+                                   Add(p, Scale(bisector, side * miterRatio)),
+                                   b};
+                    }
+                }
+            }
+            addPolygon();
+        }
+
+        if (!closed && cap == StrokeCap::round)
+        {
+            addCircle(pts.front());
+            addCircle(pts.back());
+        }
+    }
+    *fillRule = FillRule::nonZero;
+    return !edges.empty();
+}
+
+void SoftwareRenderer::drawPath(RenderPath* path, RenderPaint* paint)
+{
+    const State& state = m_stack.back();
+    FillRule fillRule;
+    if (state.clipBounds.empty() || !buildEdges(path, paint, &fillRule))
+    {
+        return;
+    }
+    auto swPaint = static_cast<SoftwareRenderPaint*>(paint);
+    BlendMode blendMode = swPaint->blendModeValue();
+    const SoftwareGradient* gradient = swPaint->gradient();
+    Color4f solid = Color4f::FromColorInt(swPaint->colorValue());
+
+    // Gradients are evaluated at pixel centers mapped back into local space.
+    Mat2D inverse;
+    if (gradient && !state.matrix.invert(&inverse))
+    {
+        return;
+    }
+    // t = dot(local - start, end - start) / |end - start|^2, which is an
+    // affine function of the device coordinate.
+    float tx = 0, ty = 0, t0 = 0;
+    if (gradient && !gradient->isRadial())
+    {
+        auto linear = static_cast<const SoftwareLinearGradient*>(gradient);
+        Vec2D v = Sub(linear->end, linear->start);
+        float len2 = Dot(v, v);
+        if (len2 > 0)
+        {
+            v = Scale(v, 1 / len2);
+        }
+        Vec2D origin = Sub(inverse * Vec2D(0, 0), linear->start);
+        Vec2D dx = Sub(inverse * Vec2D(1, 0), inverse * Vec2D(0, 0));
+        Vec2D dy = Sub(inverse * Vec2D(0, 1), inverse * Vec2D(0, 0));
+        tx = Dot(dx, v);
+        ty = Dot(dy, v);
+        t0 = Dot(origin, v);
+    }
+
+    const ClipMask* clip = state.clip.get();
+    m_edges->rasterize(
+        fillRule,
+        state.clipBounds,
+        [&](int32_t y, int32_t left, int32_t right, const float* coverage) {
+            uint8_t* row = m_pixels + (size_t)y * m_rowBytes;
+            const uint8_t* clipRow = clip ? clip->row(y) : nullptr;
+            for (int32_t x = left; x < right; ++x)
+            {
+                float c = coverage[x - left];
+                if (clipRow)
+                {
+                    c *= clipRow[x - clip->bounds.left] * (1 / 255.f);
+                }
+                if (c <= 0)
+                {
+                    continue;
+                }
+                Color4f src = solid;
+                if (gradient)
+                {
+                    float px = x + .5f, py = y + .5f;
+                    if (gradient->isRadial())
+                    {
+                        auto radial =
+                            static_cast<const SoftwareRadialGradient*>(
+                                gradient);
+                        Vec2D local = inverse * Vec2D(px, py);
+                        float t =
+                            radial->radius > 0
+                                ? Length(Sub(local, radial->center)) /
+                                      radial->radius
+                                : 1;
+                        src = gradient->colorAt(t);
+                    }
+                    else
+                    {
+                        src = gradient->colorAt(t0 + tx * px + ty * py);
+                    }
+                }
+                src = {src.r * c, src.g * c, src.b * c, src.a * c};
+                BlendPixel(blendMode, src, row + x * 4);
+            }
+        });
+}
+
+void SoftwareRenderer::clipPath(RenderPath* path)
+{
+    State& state = m_stack.back();
+    FillRule fillRule;
+    if (state.clipBounds.empty())
+    {
+        return;
+    }
+    // The mask only needs to cover the path's bounds within the current clip,
+    // and only that much of it gets cleared.
+    bool hasEdges = buildEdges(path, nullptr, &fillRule);
+    auto mask = makeClipMask(hasEdges ? m_edges->bounds(state.clipBounds)
+                                      : IRect{0, 0, 0, 0});
+    IRect bounds = {m_width, m_height, 0, 0};
+    if (!mask->bounds.empty())
+    {
+        const ClipMask* previous = state.clip.get();
+        m_edges->rasterize(
+            fillRule,
+            mask->bounds,
+            [&](int32_t y, int32_t left, int32_t right, const float* coverage) {
+                uint8_t* row = mask->row(y);
+                const uint8_t* previousRow =
+                    previous ? previous->row(y) : nullptr;
+                for (int32_t x = left; x < right; ++x)
+                {
+                    float c = coverage[x - left];
+                    if (previousRow)
+                    {
+                        c *= previousRow[x - previous->bounds.left] *
+                             (1 / 255.f);
+                    }
+                    row[x - mask->bounds.left] = (uint8_t)(c * 255 + .5f);
+                }
+                bounds.left = std::min(bounds.left, left);
+                bounds.top = std::min(bounds.top, y);
+                bounds.right = std::max(bounds.right, right);
+                bounds.bottom = std::max(bounds.bottom, y + 1);
+            });
+    }
+    state.clip = std::move(mask);
+    state.clipBounds = bounds;
+}
+
+// Images can't be created by SoftwareFactory, so there is never anything to
+// draw here.
+void SoftwareRenderer::drawImage(const RenderImage*, BlendMode, float) {}
+
+void SoftwareRenderer::drawImageMesh(const RenderImage*,
+                                     rcp<RenderBuffer>,
+                                     rcp<RenderBuffer>,
+                                     rcp<RenderBuffer>,
+                                     uint32_t,
+                                     uint32_t,
+                                     BlendMode,
+                                     float)
+{}
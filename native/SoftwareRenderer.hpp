@@ -0,0 +1,133 @@
+#pragma once
+
+#include "rive/factory.hpp"
+#include "rive/renderer.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// A rive backend that rasterizes entirely on the CPU, inside the native
+// library, with no managed callbacks. It draws into a caller-provided buffer of
+// premultiplied RGBA8888 pixels, which makes it suitable for headless
+// rendering (thumbnails, video frames) where there is no UI stack.
+//
+// Images are not supported: there is no native image decoder, so
+// decodeImage() returns null. Rather than render files with images
+// incompletely, NativeFile refuses to import them for this backend, using
+// SoftwareFactory's count of the images it couldn't decode.
+
+// Factory for the software backend. Paths, paints and gradients created here
+// may only be drawn with a SoftwareRenderer.
+class SoftwareFactory : public rive::Factory
+{
+public:
+    rive::rcp<rive::RenderBuffer> makeRenderBuffer(rive::RenderBufferType,
+                                                   rive::RenderBufferFlags,
+                                                   size_t) override;
+
+    rive::rcp<rive::RenderShader> makeLinearGradient(
+        float sx,
+        float sy,
+        float ex,
+        float ey,
+        const rive::ColorInt colors[], // [count]
+        const float stops[],           // [count]
+        size_t count) override;
+
+    rive::rcp<rive::RenderShader> makeRadialGradient(
+        float cx,
+        float cy,
+        float radius,
+        const rive::ColorInt colors[], // [count]
+        const float stops[],           // [count]
+        size_t count) override;
+
+    rive::rcp<rive::RenderPath> makeRenderPath(rive::RawPath&,
+                                               rive::FillRule) override;
+
+    rive::rcp<rive::RenderPath> makeEmptyRenderPath() override;
+
+    rive::rcp<rive::RenderPaint> makeRenderPaint() override;
+
+    rive::rcp<rive::RenderImage> decodeImage(
+        rive::Span<const uint8_t>) override;
+
+    // The number of decodeImage() calls so far, all of which returned null.
+    uint32_t undecodedImageCount() const
+    {
+        return m_undecodedImageCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> m_undecodedImageCount{0};
+};
+
+// Rasterizes into pixels[height][rowBytes], compositing over the existing
+// contents. Fills are antialiased with exact horizontal coverage and
+// kSubsamples vertical samples per pixel.
+class SoftwareRenderer : public rive::Renderer
+{
+public:
+    static constexpr int kSubsamples = 8;
+
+    SoftwareRenderer(uint8_t* pixels,
+                     int32_t width,
+                     int32_t height,
+                     int32_t rowBytes);
+    ~SoftwareRenderer() override;
+
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    void save() override;
+    void restore() override;
+    void transform(const rive::Mat2D&) override;
+    void drawPath(rive::RenderPath*, rive::RenderPaint*) override;
+    void clipPath(rive::RenderPath*) override;
+    void drawImage(const rive::RenderImage*,
+                   rive::BlendMode,
+                   float opacity) override;
+    void drawImageMesh(const rive::RenderImage*,
+                       rive::rcp<rive::RenderBuffer> vertices_f32,
+                       rive::rcp<rive::RenderBuffer> uvCoords_f32,
+                       rive::rcp<rive::RenderBuffer> indices_u16,
+                       uint32_t vertexCount,
+                       uint32_t indexCount,
+                       rive::BlendMode,
+                       float opacity) override;
+
+    struct IRect
+    {
+        int32_t left, top, right, bottom;
+        bool empty() const { return left >= right || top >= bottom; }
+    };
+
+private:
+    struct ClipMask;
+    class EdgeList;
+
+    struct State
+    {
+        rive::Mat2D matrix;
+        // Null if nothing has been clipped.
+        std::shared_ptr<const ClipMask> clip;
+        // Bounds of the clip mask, or of the whole buffer if there is none.
+        IRect clipBounds;
+    };
+
+    // Flattens the path (or its stroke, if paint is a stroke) into m_edges in
+    // device space. Returns false if there is nothing to draw.
+    bool buildEdges(rive::RenderPath*, rive::RenderPaint*, rive::FillRule*);
+
+    // Returns a cleared mask over bounds, reusing the storage of masks that
+    // are no longer referenced.
+    std::shared_ptr<ClipMask> makeClipMask(const IRect& bounds);
+
+    uint8_t* const m_pixels;
+    const int32_t m_width;
+    const int32_t m_height;
+    const int32_t m_rowBytes;
+    std::vector<std::unique_ptr<ClipMask>> m_maskPool;
+    std::vector<State> m_stack;
+    std::unique_ptr<EdgeList> m_edges;
+};
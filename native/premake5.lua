@@ -1,6 +1,6 @@
 workspace('rive-cpp')
 
-configurations({ 'Debug', 'Release' })
+configurations({ 'Debug', 'Release', 'ReleaseFast' })
 platforms({ 'x64', 'x86', 'ARM64', 'ARM' })
 
 -- Are we in the "rive-sharp" or "rive" repository?
@@ -15,6 +15,32 @@ else
     RIVE_RUNTIME_DIR = '../../runtime'
 end
 
+-- Per-platform architecture and toolset, and the SIMD instruction set that
+-- MathKernels.cpp gets built for. Platforms without a RIVE_SIMD_* define use
+-- the scalar kernels.
+function platform_settings()
+    filter('platforms:x64')
+    architecture('x64')
+    toolset('clang')
+    defines({ 'RIVE_SIMD_SSE2' })
+
+    filter('platforms:x86')
+    architecture('x86')
+    toolset('clang')
+    defines({ 'RIVE_SIMD_SSE2' })
+
+    filter('platforms:ARM64')
+    architecture('ARM64')
+    toolset('clang')
+    defines({ 'RIVE_SIMD_NEON' })
+
+    filter('platforms:ARM')
+    architecture('ARM')
+    toolset('msc') -- clang isn't supported on ARM32
+
+    filter({})
+end
+
 project('rive')
 kind('SharedLib')
 language('C++')
@@ -24,10 +50,34 @@ objdir('obj/%{cfg.platform}/%{cfg.buildcfg}')
 staticruntime('off') -- /MD for dll
 flags({ 'FatalCompileWarnings' })
 includedirs({ RIVE_RUNTIME_DIR .. '/include', '../../include' })
-files({ RIVE_RUNTIME_DIR .. '/src/**.cpp', 'RiveSharpInterop.cpp' })
+files({
+    RIVE_RUNTIME_DIR .. '/src/**.cpp',
+    'RiveSharpInterop.cpp',
+    'SoftwareRenderer.cpp',
+    'MathKernels.cpp',
+})
 -- this is building the actual rive library so it seems we need this here.
 defines({ '_RIVE_INTERNAL_' })
 
+-- librive.so only exports the RIVE_DLL functions (see RIVE_EXPORT).
+filter('system:linux')
+pic('On')
+visibility('Hidden')
+links({ 'pthread' })
+
+-- Clang fuses a*b + c*d into FMAs by default on ARM64, which rounds
+-- differently from the managed ports of rive's Mat2D and computeAlignment math
+-- (see 2D.cs). Only the sources those ports mirror are built without it:
+-- Mat2D, computeAlignment, and RiveSharpInterop.cpp, where the reference
+-- exports inline Mat2D * Vec2D. The rest of the runtime keeps its FMAs. (MSVC
+-- doesn't contract under its default /fp:precise.)
+filter({
+    'toolset:clang',
+    'files:' .. RIVE_RUNTIME_DIR .. '/src/math/mat2d.cpp or '
+        .. RIVE_RUNTIME_DIR .. '/src/renderer.cpp or RiveSharpInterop.cpp',
+})
+buildoptions({ '-ffp-contract=off' })
+
 filter('configurations:Debug')
 defines({ 'DEBUG' })
 symbols('On')
@@ -37,20 +87,111 @@ defines({ 'RELEASE' })
 defines({ 'NDEBUG' })
 optimize('Size')
 
-filter('platforms:x64')
-architecture('x64')
-toolset('clang')
+-- Trades binary size for frame time: -O3 and ThinLTO across the runtime and
+-- interop sources, optionally guided by a profile (see --pgo-generate and
+-- --pgo-use below, and README.txt).
+filter('configurations:ReleaseFast')
+defines({ 'RELEASE' })
+defines({ 'NDEBUG' })
+optimize('Full')
+
+-- The objects are LLVM bitcode, which only lld can link: the Visual Studio
+-- ClangCL toolset would otherwise link with link.exe. lld-link (Windows)
+-- recognizes the bitcode by itself; the clang driver (elsewhere) also needs
+-- -flto at link time to run the ThinLTO backend.
+filter({ 'configurations:ReleaseFast', 'toolset:clang' })
+buildoptions({ '-flto=thin' })
+linker('LLD')
+
+filter({ 'configurations:ReleaseFast', 'toolset:clang', 'system:not windows' })
+linkoptions({ '-flto=thin' })
+
+filter({ 'configurations:ReleaseFast', 'toolset:msc' })
+flags({ 'LinkTimeOptimization' })
+
+filter({
+    'configurations:ReleaseFast',
+    'toolset:clang',
+    'options:pgo-generate',
+})
+buildoptions({ '-fprofile-instr-generate' })
+
+filter({
+    'configurations:ReleaseFast',
+    'toolset:clang',
+    'options:pgo-generate',
+    'system:not windows',
+})
+linkoptions({ '-fprofile-instr-generate' })
 
-filter('platforms:x86')
-architecture('x86')
-toolset('clang')
+if _OPTIONS['pgo-use'] then
+    filter({ 'configurations:ReleaseFast', 'toolset:clang' })
+    buildoptions({
+        '-fprofile-instr-use=' .. path.getabsolute(_OPTIONS['pgo-use']),
+        -- Code the benchmark never reaches, or that changed since the profile
+        -- was collected, is still built, just without profile data.
+        '-Wno-profile-instr-unprofiled',
+        '-Wno-profile-instr-out-of-date',
+        '-Wno-profile-instr-missing',
+    })
+end
+
+platform_settings()
+
+-- Drives the exported C API headlessly with counting stub delegates, checking
+-- ref lifetimes and call counts and timing advance and draw per file:
+--   bin/<platform>/<config>/interopharness [--frames 300] file.riv...
+project('interopharness')
+kind('ConsoleApp')
+language('C++')
+cppdialect('C++17')
+targetdir('bin/%{cfg.platform}/%{cfg.buildcfg}')
+objdir('obj/interopharness/%{cfg.platform}/%{cfg.buildcfg}')
+flags({ 'FatalCompileWarnings' })
+files({ 'InteropHarness.cpp' })
+links({ 'rive' })
+
+filter('system:linux')
+-- Find librive.so next to the executable.
+linkoptions({ "-Wl,-rpath,'$$ORIGIN'" })
+
+filter('configurations:Debug')
+symbols('On')
+
+filter('configurations:Release or ReleaseFast')
+defines({ 'NDEBUG' })
+optimize('Speed')
+
+platform_settings()
+
+-- Checks the SIMD kernels against the scalar ones and times both:
+--   bin/<platform>/Release/kernelbench [iterations]
+project('kernelbench')
+kind('ConsoleApp')
+language('C++')
+cppdialect('C++17')
+targetdir('bin/%{cfg.platform}/%{cfg.buildcfg}')
+objdir('obj/kernelbench/%{cfg.platform}/%{cfg.buildcfg}')
+flags({ 'FatalCompileWarnings' })
+includedirs({ RIVE_RUNTIME_DIR .. '/include' })
+files({ 'MathKernels.cpp', 'KernelBench.cpp' })
+
+filter('configurations:Debug')
+symbols('On')
+
+filter('configurations:Release or ReleaseFast')
+defines({ 'NDEBUG' })
+optimize('Speed')
 
-filter('platforms:ARM64')
-architecture('ARM64')
-toolset('clang')
+platform_settings()
 
-filter('platforms:ARM')
-architecture('ARM')
-toolset('msc') -- clang isn't supported on ARM32
+newoption({
+    trigger = 'pgo-generate',
+    description = 'ReleaseFast: instrument rive to collect a clang profile',
+})
 
-filter({})
+newoption({
+    trigger = 'pgo-use',
+    value = 'FILE',
+    description = 'ReleaseFast: optimize rive with a merged .profdata profile',
+})
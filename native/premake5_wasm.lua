@@ -32,16 +32,32 @@ do
     optimize('Size')
     flags({ 'FatalCompileWarnings' })
     includedirs({ RIVE_RUNTIME_DIR .. '/include', '../../include' })
-    files({ RIVE_RUNTIME_DIR .. '/src/**.cpp', 'RiveSharpInterop.cpp' })
+    files({
+        RIVE_RUNTIME_DIR .. '/src/**.cpp',
+        'RiveSharpInterop.cpp',
+        'SoftwareRenderer.cpp',
+        'MathKernels.cpp',
+    })
     defines({ 'RELEASE', 'NDEBUG', 'WASM' })
     filter('options:not no-exceptions')
     do
         -- WebAssembly Exceptions support is now required by Uno.
         buildoptions({ '-fwasm-exceptions' })
     end
+    filter('options:not no-simd')
+    do
+        -- 128-bit SIMD for MathKernels.cpp.
+        buildoptions({ '-msimd128' })
+        defines({ 'RIVE_SIMD_WASM' })
+    end
 end
 
 newoption({
     trigger = 'no-exceptions',
     description = 'build without -fwasm-exceptions',
 })
+
+newoption({
+    trigger = 'no-simd',
+    description = 'build the scalar MathKernels, for runtimes without SIMD128',
+})